@@ -2,13 +2,22 @@ in vec2 vUV;
 in float vAlpha;
 in float vWhiteOut;
 
-uniform sampler2D spriteSheet;
+// Samplers default to lowp in ES, which can't resolve all 256 indices.
+uniform highp sampler2D spriteSheet;
+uniform sampler2D palette;
+uniform bool indexed;
 
 out vec4 fragColor;
 
 void main() {
-    fragColor = texture(spriteSheet, vUV);
-    if (vWhiteOut > 0.0) fragColor.rgb = vec3(1.0);
+    if (indexed) {
+        // Row 1 of the palette is the whiteOut version.
+        int index = int(texture(spriteSheet, vUV).r * 255.0 + 0.5);
+        fragColor = texelFetch(palette, ivec2(index, vWhiteOut > 0.0 ? 1 : 0), 0);
+    } else {
+        fragColor = texture(spriteSheet, vUV);
+        if (vWhiteOut > 0.0) fragColor.rgb = vec3(1.0);
+    }
     fragColor.a *= vAlpha;
     fragColor.rgb *= fragColor.a;
 }
@@ -4,10 +4,12 @@ layout (location=2) in vec2 panelIndex;
 layout (location=3) in float scale;
 layout (location=4) in float alpha;
 layout (location=5) in float whiteOut;
+layout (location=6) in vec2 previousPixelOffset;
 
 uniform vec2 panelPixelSize;
 uniform vec2 spriteSheetDimensions;
 uniform vec2 pixelClipSize;
+uniform float interpolation;
 
 out vec2 vUV;
 out float vAlpha;
@@ -18,6 +20,8 @@ void main() {
     vUV = (uv + panelIndex) / spriteSheetDimensions;
     vWhiteOut = whiteOut;
     vAlpha = alpha;
-    vec2 clipOffset = pixelOffset * pixelClipSize - 1.0;
+    // Positions are interpolated between simulation ticks.
+    vec2 offset = mix(previousPixelOffset, pixelOffset, interpolation);
+    vec2 clipOffset = offset * pixelClipSize - 1.0;
     gl_Position = vec4((vertexPosition * panelPixelSize * pixelClipSize * scale + clipOffset) * vec2(1.0, -1.0), 0.0, 1.0);
 }
@@ -21,10 +21,12 @@
 // CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 ////////////////////////////////////////////////////////////////////////////////////
 
+#include <string.h>
 #include "entities.h"
 
 void entities_updateAnimationPanel(Entities_List* list, int32_t i) {
-    float* panel = list->sprite->animations[list->currentAnimation[i]].frames[list->animationTick[i]];
+    Data_Animations* animations = &list->sprite->animations;
+    uint8_t* panel = animations->frames + (animations->animations[list->currentAnimation[i]].firstFrame + list->animationTick[i]) * 2;
     float* currentSpritePanel = list->currentSpritePanel + i * 2;
 
     currentSpritePanel[0] = panel[0];
@@ -43,12 +45,12 @@ void entities_setAnimation(Entities_List* list, int32_t i, int32_t animation) {
 
 void entities_updateAnimations(Entities_List* list) {
     for (int32_t i = 0; i < list->count; ++i) {
-        int32_t numFrames = list->sprite->animations[list->currentAnimation[i]].numFrames;
+        Data_Animation* animation = list->sprite->animations.animations + list->currentAnimation[i];
         ++list->animationTick[i];
-        if (list->animationTick[i] == numFrames) {
-            Sprites_AnimationEndBehavior endBehavior = list->sprite->animations[list->currentAnimation[i]].endBehavior;
 
-            if (endBehavior == SPRITES_ANIMATION_END_KILL) {
+        // >= since the animation might have been shortened by a hot reload.
+        if (list->animationTick[i] >= animation->numFrames) {
+            if (animation->endBehavior == DATA_ANIMATION_END_KILL) {
                 list->dead[i] = true;
                 continue;
             } else {
@@ -71,6 +73,8 @@ void entities_spawn(Entities_List* list, Entities_InitOptions* opts) {
 
     position[0] = opts->x; 
     position[1] = opts->y;
+    list->previousPosition[i * 2]     = opts->x;
+    list->previousPosition[i * 2 + 1] = opts->y;
     velocity[0] = opts->vx;
     velocity[1] = opts->vy;
     list->currentAnimation[i] = opts->currentAnimation;
@@ -81,7 +85,7 @@ void entities_spawn(Entities_List* list, Entities_InitOptions* opts) {
     list->whiteOut[i]         = opts->whiteOut;
     list->dead[i]             = false;
 
-    if (list->sprite->animations) {
+    if (list->sprite->animations.animations) {
         entities_updateAnimationPanel(list, i);
     }
 
@@ -102,6 +106,8 @@ void entities_filterDead(Entities_List* list) {
             position[1] = lastPosition[1];
             velocity[0] = lastVelocity[0];
             velocity[1] = lastVelocity[1];
+            list->previousPosition[i * 2]     = list->previousPosition[last * 2];
+            list->previousPosition[i * 2 + 1] = list->previousPosition[last * 2 + 1];
             list->currentAnimation[i] = list->currentAnimation[last];
             list->animationTick[i]    = list->animationTick[last];
             list->scale[i]            = list->scale[last];
@@ -144,3 +150,7 @@ void entities_fromText(Entities_List* list, const char* text, Entities_FromTextO
     }
 
 }
+
+void entities_savePositions(Entities_List* list) {
+    memcpy(list->previousPosition, list->position, list->count * 2 * sizeof(float));
+}
@@ -41,8 +41,8 @@
 // Members:
 // - velocity: current velocity of the entity
 // - currentSpritePanel: current sprite panel to draw
-// - currentAnimation: index of the current animation in the sprite 
-//      animations array.
+// - currentAnimation: index of the current animation in the sprite's
+//      animation table.
 // - health: enemy hit point
 // - dead: whether the entity should be removed from the list 
 //      (performed by entities_filterDead() at the end of a frame)
@@ -97,6 +97,8 @@ typedef struct {
 //      animation panels for all entities in the list.
 // - entities_fromText(): Create and entity representation of the 
 //      provided string.
+// - entities_savePositions(): Copy current positions to previous
+//      positions (called at the start of a simulation tick).
 ///////////////////////////////////////////////////////////////////////
 
 void entities_spawn(Entities_List* list, Entities_InitOptions* opts);
@@ -106,5 +108,6 @@ void entities_setAnimation(Entities_List* list, int32_t i, int32_t animation);
 void entities_updateAnimationPanel(Entities_List* list, int32_t i);
 void entities_updateAnimations(Entities_List* list);
 void entities_fromText(Entities_List* list, const char* text, Entities_FromTextOptions* opts);
+void entities_savePositions(Entities_List* list);
 
 #endif
@@ -24,11 +24,14 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
 #include <math.h>
 #include "../../lib/simple-opengl-loader.h"
+#include "../shared/constants.h"
 #include "../shared/data.h"
 #include "../shared/platform-interface.h"
 #include "../shared/utils.h"
+#include "../shared/debug.h"
 #include "renderer.h"
 #include "sprites.h"
 #include "entities.h"
@@ -40,7 +43,10 @@
 
 #define GAME_WIDTH 320
 #define GAME_HEIGHT 180
-#define TICK_DURATION 16.6667f
+#define DEFAULT_TICK_RATE 60 // Ticks per second
+#define MIN_TICK_RATE 60
+#define MAX_TICK_RATE 240
+#define MAX_ELAPSED_TIME 33.3f // Longer frames are clamped, so the game slows down rather than catching up
 #define COLLISION_SCALE 0.7f   // Scale factor on collision boxes when detecting collisions
 #define TIME_PER_ANIMATION 100.0f // Time per frame of a sprite animation
 #define SCORE_TEXT_LENGTH 5 
@@ -92,6 +98,21 @@
 #define STARS_MIN_TRANSPARENCY 0.0f
 #define STARS_MAX_TRANSPARENCY 0.9f
 
+//////////////////////////////////
+//  Audio constants
+//////////////////////////////////
+
+#define MUSIC_PRIORITY 3
+#define EXPLOSION_PRIORITY 2
+#define EXPLOSION_MAX_INSTANCES 4
+#define ENEMY_HIT_PRIORITY 1
+#define ENEMY_HIT_MAX_INSTANCES 3
+#define PLAYER_BULLET_PRIORITY 1
+#define PLAYER_BULLET_MAX_INSTANCES 3
+#define ENEMY_BULLET_PRIORITY 0
+#define ENEMY_BULLET_MAX_INSTANCES 4
+#define SOUND_PAN_WIDTH 0.8f
+
 //////////////////////////////////
 //  Level transition constants
 //////////////////////////////////
@@ -131,9 +152,14 @@ static struct {
         MAIN_GAME,
         GAME_OVER
     } state;
+    float tickDuration;
     float tickTime;
+    uint32_t tick;
     float animationTime;
     bool hideSystemInstructions;
+    bool simulationThread;
+    int64_t inputTime;       // Newest input consumed by the simulation
+    int64_t drawnInputTime;  // Newest input reflected in the last frame drawn
     char scoreText[SCORE_TEXT_LENGTH];
 } gameState;
 
@@ -178,6 +204,13 @@ static struct {
     } sounds;
     uint8_t whitePixel[4];
 } gameData = {
+    .sounds = {
+        .music = -1,
+        .playerBullet = -1,
+        .enemyBullet = -1,
+        .explosion = -1,
+        .enemyHit = -1
+    },
     .whitePixel = {255, 255, 255, 255}
 };
 
@@ -206,20 +239,315 @@ static struct {
 
 
 //////////////////////////////////
-//  Data load helpers
+//  Asset loading
 //////////////////////////////////
 
-static bool loadTexture(const char* fileName, uint32_t *texture) {
-    Data_Image image = { 0 };
+///////////////////////////////////////////////////////////
+// Assets are decoded by jobs on the platform's worker
+// threads. Textures are uploaded on the main thread as
+// their jobs complete, since that's where GL calls have
+// to be made. Sounds are loaded into the platform audio
+// system directly by their jobs, and are finished by
+// whichever thread runs the simulation, since that's
+// where they're played. Animation tables are tiny, so
+// they're loaded directly in game_init().
+///////////////////////////////////////////////////////////
+
+#define NUM_TEXTURE_LOADS 7
+#define NUM_SOUND_LOADS 5
+#define NUM_ANIMATION_LOADS 8
 
-    bool result = utils_loadBmpData(fileName, &image);
-    
-    *texture = renderer_createTexture(image.data, image.width, image.height);
-    data_freeImage(&image);
+typedef struct {
+    const char* fileName;
+    Sprites_Sprite* sprite;
+    Sprites_Sprite* sharedSprite; // Uses the same texture, may be NULL
+    bool title; // Needed by the title screen
+    Data_Image image;
+    bool loaded;
+    bool pending;
+    int32_t job;
+} TextureLoad;
+
+typedef struct {
+    const char* fileName;
+    Game_SoundOptions options;
+    int32_t* id;
+    int32_t loadedId;
+    bool pending;
+    int32_t job;
+} SoundLoad;
+
+typedef struct {
+    const char* fileName;
+    Sprites_Sprite* sprite;
+    int32_t numAnimations; // Number of animations the game indexes
+    volatile int32_t reloadPending; // Reloads wait for the simulation thread
+} AnimationLoad;
+
+static struct {
+    TextureLoad textures[NUM_TEXTURE_LOADS];
+    SoundLoad sounds[NUM_SOUND_LOADS];
+    AnimationLoad animations[NUM_ANIMATION_LOADS];
+    bool textureFailed;
+    bool soundFailed;
+} assetLoads = {
+    .textures = {
+        { .fileName = "assets/sprites/ship.bmp", .sprite = &sprites_player, .title = true },
+        { .fileName = "assets/sprites/pixelspritefont32.bmp", .sprite = &sprites_text, .title = true },
+        { .fileName = "assets/sprites/enemy-small.bmp", .sprite = &sprites_smallEnemy },
+        { .fileName = "assets/sprites/enemy-medium.bmp", .sprite = &sprites_mediumEnemy },
+        { .fileName = "assets/sprites/enemy-big.bmp", .sprite = &sprites_largeEnemy },
+        { .fileName = "assets/sprites/explosion.bmp", .sprite = &sprites_explosion },
+        { .fileName = "assets/sprites/laser-bolts.bmp", .sprite = &sprites_playerBullet, .sharedSprite = &sprites_enemyBullet }
+    },
+    // IMA ADPCM handles the square waves in the short effects poorly, so
+    // only the music and the (noisy) explosion are compressed.
+    .sounds = {
+        {
+            .fileName = "assets/audio/music.wav",
+            .options = { .priority = MUSIC_PRIORITY, .compress = true },
+            .id = &gameData.sounds.music
+        },
+        {
+            .fileName = "assets/audio/Laser_002.wav",
+            .options = { .priority = PLAYER_BULLET_PRIORITY, .maxInstances = PLAYER_BULLET_MAX_INSTANCES },
+            .id = &gameData.sounds.playerBullet
+        },
+        {
+            .fileName = "assets/audio/Hit_Hurt2.wav",
+            .options = { .priority = ENEMY_BULLET_PRIORITY, .maxInstances = ENEMY_BULLET_MAX_INSTANCES },
+            .id = &gameData.sounds.enemyBullet
+        },
+        {
+            .fileName = "assets/audio/Explode1.wav",
+            .options = { .priority = EXPLOSION_PRIORITY, .maxInstances = EXPLOSION_MAX_INSTANCES, .compress = true },
+            .id = &gameData.sounds.explosion
+        },
+        {
+            .fileName = "assets/audio/Jump1.wav",
+            .options = { .priority = ENEMY_HIT_PRIORITY, .maxInstances = ENEMY_HIT_MAX_INSTANCES },
+            .id = &gameData.sounds.enemyHit
+        }
+    },
+    .animations = {
+        { .fileName = "assets/sprites/ship.anim", .sprite = &sprites_player, .numAnimations = SPRITES_PLAYER_NUM_ANIMATIONS },
+        { .fileName = "assets/sprites/pixelspritefont32.anim", .sprite = &sprites_text, .numAnimations = SPRITES_TEXT_NUM_ANIMATIONS },
+        { .fileName = "assets/sprites/enemy-small.anim", .sprite = &sprites_smallEnemy, .numAnimations = 1 },
+        { .fileName = "assets/sprites/enemy-medium.anim", .sprite = &sprites_mediumEnemy, .numAnimations = 1 },
+        { .fileName = "assets/sprites/enemy-big.anim", .sprite = &sprites_largeEnemy, .numAnimations = 1 },
+        { .fileName = "assets/sprites/explosion.anim", .sprite = &sprites_explosion, .numAnimations = 1 },
+        { .fileName = "assets/sprites/player-bullet.anim", .sprite = &sprites_playerBullet, .numAnimations = 1 },
+        { .fileName = "assets/sprites/enemy-bullet.anim", .sprite = &sprites_enemyBullet, .numAnimations = 1 }
+    }
+};
+
+// The sprite's table is only replaced if the new one has
+// all the animations the game uses.
+static bool loadAnimations(AnimationLoad* load) {
+    Data_Animations animations = { 0 };
+
+    if (!utils_loadAnimationData(load->fileName, &animations)) {
+        return false;
+    }
+
+    if (animations.numAnimations < load->numAnimations) {
+        DEBUG_LOG("game_loadAnimations: Missing animations.");
+        data_freeAnimations(&animations);
+        return false;
+    }
+
+    data_freeAnimations(&load->sprite->animations);
+    load->sprite->animations = animations;
+
+    return true;
+}
+
+static void loadImageJob(void* data) {
+    TextureLoad* load = (TextureLoad *) data;
+    load->loaded = utils_loadBmpData(load->fileName, &load->image);
+}
+
+static void loadSoundJob(void* data) {
+    SoundLoad* load = (SoundLoad *) data;
+    load->loadedId = platform_loadSound(load->fileName, &load->options);
+}
+
+// Platforms without workers leave jobs to the game.
+static int32_t startJob(void (*function)(void* data), void* data) {
+    int32_t job = platform_addJob(function, data);
+
+    if (job == -1) {
+        function(data);
+    }
+
+    return job;
+}
+
+static void startTextureLoads(void) {
+    for (int32_t i = 0; i < NUM_TEXTURE_LOADS; ++i) {
+        TextureLoad* load = assetLoads.textures + i;
+        load->pending = true;
+        load->job = startJob(loadImageJob, load);
+    }
+}
+
+// Indexed images are uploaded with their palette.
+static void uploadTexture(TextureLoad* load, Data_Image* image) {
+    if (image->palette) {
+        load->sprite->texture = renderer_createIndexedTexture(image->data, image->width, image->height);
+        load->sprite->palette = renderer_createPalette(image->palette);
+    } else {
+        load->sprite->texture = renderer_createTexture(image->data, image->width, image->height);
+        load->sprite->palette = 0;
+    }
+
+    if (load->sharedSprite) {
+        load->sharedSprite->texture = load->sprite->texture;
+        load->sharedSprite->palette = load->sprite->palette;
+    }
+}
+
+static bool finishTextureLoad(TextureLoad* load) {
+    platform_startupPhase(load->fileName);
+    load->pending = false;
+
+    if (!load->loaded) {
+        return false;
+    }
+
+    uploadTexture(load, &load->image);
+    data_freeImage(&load->image);
+
+    return renderer_validate();
+}
+
+static void finishSoundLoad(SoundLoad* load) {
+    load->pending = false;
+    *load->id = load->loadedId;
+
+    if (load->loadedId == -1) {
+        assetLoads.soundFailed = true;
+    }
+
+    if (load->id == &gameData.sounds.music) {
+        platform_playSound(gameData.sounds.music, &(Game_PlaySoundOptions) {
+            .loop = true
+        });
+    }
+}
+
+// Block until textures are uploaded (only those needed
+// by the title screen if `titleOnly` is set).
+static bool waitForTextures(bool titleOnly) {
+    bool result = true;
+
+    for (int32_t i = 0; i < NUM_TEXTURE_LOADS; ++i) {
+        TextureLoad* load = assetLoads.textures + i;
+
+        if (!load->pending || (titleOnly && !load->title)) {
+            continue;
+        }
+
+        platform_waitForJob(load->job);
+        result = finishTextureLoad(load) && result;
+    }
 
     return result;
 }
 
+// Handle any jobs that have completed since the last frame.
+static void updateTextureLoads(void) {
+    for (int32_t i = 0; i < NUM_TEXTURE_LOADS; ++i) {
+        TextureLoad* load = assetLoads.textures + i;
+
+        if (load->pending && platform_jobComplete(load->job) && !finishTextureLoad(load) && !assetLoads.textureFailed) {
+            assetLoads.textureFailed = true;
+            platform_userMessage("Unable to load textures.");
+        }
+    }
+}
+
+static void updateSoundLoads(void) {
+    bool soundsPending = false;
+    bool soundsFinished = false;
+
+    for (int32_t i = 0; i < NUM_SOUND_LOADS; ++i) {
+        SoundLoad* load = assetLoads.sounds + i;
+
+        if (load->pending && platform_jobComplete(load->job)) {
+            finishSoundLoad(load);
+            soundsFinished = true;
+        }
+
+        soundsPending = soundsPending || load->pending;
+    }
+
+    if (soundsFinished && !soundsPending && assetLoads.soundFailed) {
+        platform_userMessage("Unable to load all audio.");
+    }
+}
+
+static void updateAnimationReloads(void) {
+    for (int32_t i = 0; i < NUM_ANIMATION_LOADS; ++i) {
+        AnimationLoad* load = assetLoads.animations + i;
+
+        if (utils_atomicLoad(&load->reloadPending) && utils_atomicExchange(&load->reloadPending, 0) && !loadAnimations(load)) {
+            DEBUG_LOG("game_reloadAsset: Unable to reload animations.");
+        }
+    }
+}
+
+//////////////////////////////////
+//  Audio helpers
+//////////////////////////////////
+
+// Pan a sound to match its horizontal position on screen.
+static void playSoundAt(int32_t id, float x) {
+    float pan = (x / GAME_WIDTH) * 2.0f - 1.0f;
+    if (pan < -1.0f) {
+        pan = -1.0f;
+    }
+    if (pan > 1.0f) {
+        pan = 1.0f;
+    }
+
+    platform_playSound(id, &(Game_PlaySoundOptions) {
+        .pan = pan * SOUND_PAN_WIDTH,
+        .tick = gameState.tick
+    });
+}
+
+#ifdef SPACE_SHOOTER_DEBUG
+// Report audio stats whenever the mixer drops audio or sounds.
+static void logAudioStats(void) {
+    static Game_AudioStats lastStats = { 0 };
+    Game_AudioStats stats = { 0 };
+
+    if (!platform_getAudioStats(&stats)) {
+        return;
+    }
+
+    if (stats.xruns != lastStats.xruns || stats.droppedRequests != lastStats.droppedRequests) {
+        char message[256];
+        snprintf(
+            message,
+            sizeof(message),
+            "Audio: %u xruns, %u dropped requests, mix %.2fms (max %.2fms) of %.2fms period, %d voices, queue high-water %d",
+            stats.xruns,
+            stats.droppedRequests,
+            (double) stats.mixTime / SPACE_SHOOTER_MILLISECOND,
+            (double) stats.maxMixTime / SPACE_SHOOTER_MILLISECOND,
+            (double) stats.periodTime / SPACE_SHOOTER_MILLISECOND,
+            stats.activeVoices,
+            stats.queueHighWater
+        );
+        DEBUG_LOG(message);
+    }
+
+    lastStats = stats;
+}
+#endif
+
 //////////////////////////////////
 //  Level transition helpers
 //////////////////////////////////
@@ -241,13 +569,127 @@ static void transitionLevel(void) {
     events_start(&events_levelTransitionSequence);
 }
 
+//////////////////////////////////
+//  Input
+//////////////////////////////////
+
+///////////////////////////////////////////////////////////
+// Shoot presses and releases are queued with the
+// platform's timestamps, and each tick applies the ones
+// that happened before it ends, so taps shorter than a
+// tick aren't lost and several taps in one frame all
+// count. The simulation is behind the platform's clock by
+// the time still in gameState.tickTime, so a tick ends at
+// the time input was read minus whatever will be left
+// over after it. Platforms that don't queue events only
+// report the current state, which is queued as a change
+// at the start of the next tick.
+///////////////////////////////////////////////////////////
+
+#define INPUT_QUEUE_SIZE (2 * GAME_INPUT_MAX_EVENTS)
+#define MAX_TICK_PRESSES 4
+
+static struct {
+    Game_Input platform;
+    Game_InputEvent queue[INPUT_QUEUE_SIZE]; // In time order
+    int32_t count;
+    bool queuedShoot; // Shoot state after the last event queued
+    float pressTimes[MAX_TICK_PRESSES]; // Time from each press in the current tick to the end of it
+    int32_t pressCount;
+} inputQueue;
+
+static void queueInputEvent(Game_InputEvent* event) {
+    inputQueue.queuedShoot = event->shoot;
+
+    if (inputQueue.count == INPUT_QUEUE_SIZE) {
+        DEBUG_LOG("queueInputEvent: Input queue full. Dropping event.");
+        return;
+    }
+
+    // Events from different devices can arrive out of order.
+    int32_t i = inputQueue.count;
+
+    while (i > 0 && inputQueue.queue[i - 1].time > event->time) {
+        inputQueue.queue[i] = inputQueue.queue[i - 1];
+        --i;
+    }
+
+    inputQueue.queue[i] = *event;
+    ++inputQueue.count;
+}
+
+static void pollInput(void) {
+    Game_Input* input = &inputQueue.platform;
+    platform_getInput(input);
+
+    for (int32_t i = 0; i < input->eventCount; ++i) {
+        queueInputEvent(input->events + i);
+    }
+
+    input->eventCount = 0;
+
+    // Platforms that don't queue events, or events that were dropped.
+    if (input->shoot != inputQueue.queuedShoot) {
+        queueInputEvent(&(Game_InputEvent) {
+            .time = input->sampleTime,
+            .shoot = input->shoot
+        });
+    }
+}
+
+// Must be called before gameState.tickTime is reduced for the tick.
+static void updateTickInput(void) {
+    Game_Input* platformInput = &inputQueue.platform;
+    Game_Input* input = &gameState.input;
+    int64_t tickEnd = 0;
+
+    if (platformInput->sampleTime) {
+        tickEnd = platformInput->sampleTime - (int64_t) ((gameState.tickTime - gameState.tickDuration) * (float) SPACE_SHOOTER_MILLISECOND);
+    }
+
+    input->lastShoot = input->shoot;
+    input->velocity[0] = platformInput->velocity[0];
+    input->velocity[1] = platformInput->velocity[1];
+    input->keyboard = platformInput->keyboard;
+    input->time = platformInput->time;
+    inputQueue.pressCount = 0;
+
+    int32_t consumed = 0;
+
+    while (consumed < inputQueue.count && inputQueue.queue[consumed].time <= tickEnd) {
+        Game_InputEvent* event = inputQueue.queue + consumed;
+
+        if (event->shoot && !input->shoot && inputQueue.pressCount < MAX_TICK_PRESSES) {
+            float timeLeft = (float) (tickEnd - event->time) / (float) SPACE_SHOOTER_MILLISECOND;
+
+            // Events from before the tick started (e.g. when a
+            // long frame was clamped) happen at its start.
+            if (timeLeft > gameState.tickDuration) {
+                timeLeft = gameState.tickDuration;
+            }
+
+            inputQueue.pressTimes[inputQueue.pressCount] = timeLeft;
+            ++inputQueue.pressCount;
+        }
+
+        input->shoot = event->shoot;
+        ++consumed;
+    }
+
+    inputQueue.count -= consumed;
+    memmove(inputQueue.queue, inputQueue.queue + consumed, inputQueue.count * sizeof(Game_InputEvent));
+}
+
 //////////////////////////////////
 //  Player helpers
 //////////////////////////////////
 
-static void firePlayerBullet(float x, float y) {
+// `timeLeft` is the time from the press to the end of
+// the tick. The bullet is moved that far, and the
+// throttle is checked and set as of the press.
+static void firePlayerBullet(float x, float y, float timeLeft) {
     if (
-        entities.player.bulletThrottle > 0.0f || 
+        entities.player.bulletThrottle + timeLeft > 0.0f || 
         entities.player.deadTimer > 0.0f
     ) {
         return;
@@ -255,11 +697,11 @@ static void firePlayerBullet(float x, float y) {
 
     entities_spawn(&entities.playerBullets, &(Entities_InitOptions) {
         .x = x, 
-        .y = y, 
+        .y = y + PLAYER_BULLET_VELOCITY * timeLeft, 
         .vy = PLAYER_BULLET_VELOCITY
     });
-    platform_playSound(gameData.sounds.playerBullet, false);
-    entities.player.bulletThrottle = PLAYER_BULLET_THROTTLE;
+    playSoundAt(gameData.sounds.playerBullet, x);
+    entities.player.bulletThrottle = PLAYER_BULLET_THROTTLE - timeLeft;
 }
 
 static bool checkPlayerBulletCollision(
@@ -291,11 +733,11 @@ static bool checkPlayerBulletCollision(
                     .x = position[0] + explosionXOffset, 
                     .y = position[1] + explosionYOffset
                 });
-                platform_playSound(gameData.sounds.explosion, false);
+                playSoundAt(gameData.sounds.explosion, position[0]);
                 enemies->dead[i] = true;
                 entities.player.score += points;
             } else {
-                platform_playSound(gameData.sounds.enemyHit, false);
+                playSoundAt(gameData.sounds.enemyHit, position[0]);
                 enemies->whiteOut[i] = ENEMY_WHITEOUT_TIME;
             }
         }    
@@ -344,7 +786,7 @@ static void fireEnemyBullet(float x, float y) {
         .vy = (dy / d) * ENEMY_BULLET_SPEED
     });
 
-    platform_playSound(gameData.sounds.enemyBullet, false);
+    playSoundAt(gameData.sounds.enemyBullet, x);
 }
 
 //////////////////////////////////
@@ -375,6 +817,8 @@ static void updateEntities(Entities_List* list, float elapsedTime, float offscre
     }
 }
 
+// Time past the animation frame carries over, so animations
+// run at the same speed at any tick rate.
 static void updateAnimations(void) {
     if (gameState.animationTime > TIME_PER_ANIMATION) {
         entities_updateAnimations(&entities.player.entity);  
@@ -385,10 +829,23 @@ static void updateAnimations(void) {
         entities_updateAnimations(&entities.enemyBullets);  
         entities_updateAnimations(&entities.explosions);
 
-        gameState.animationTime = 0.0f;
+        gameState.animationTime -= TIME_PER_ANIMATION;
     }
 }
 
+static void savePositions(void) {
+    entities_savePositions(&entities.player.entity);
+    entities_savePositions(&entities.smallEnemies);
+    entities_savePositions(&entities.mediumEnemies);
+    entities_savePositions(&entities.largeEnemies);
+    entities_savePositions(&entities.playerBullets);
+    entities_savePositions(&entities.enemyBullets);
+    entities_savePositions(&entities.explosions);
+    entities_savePositions(&entities.stars);
+    entities_savePositions(&entities.text);
+    entities_savePositions(&entities.lives);
+}
+
 static void filterDeadEntities(void) {
     entities_filterDead(&entities.playerBullets);  
     entities_filterDead(&entities.smallEnemies);
@@ -501,15 +958,21 @@ static void simWorld(float elapsedTime) {
 }
 
 static void simPlayer(float elapsedTime) {
-    platform_getInput(&gameState.input);
-
     // Process player input
     Player* player = &entities.player;
     player->velocity[0] = PLAYER_VELOCITY * gameState.input.velocity[0];
     player->velocity[1] = -PLAYER_VELOCITY * gameState.input.velocity[1];
 
-    if (gameState.input.shoot && !gameState.input.lastShoot) {
-        firePlayerBullet(player->position[0] + SPRITES_PLAYER_BULLET_X_OFFSET, player->position[1] + SPRITES_PLAYER_BULLET_Y_OFFSET);
+    // Fired from where the player was at the time of each press.
+    for (int32_t i = 0; i < inputQueue.pressCount; ++i) {
+        float timeLeft = inputQueue.pressTimes[i];
+        float timeIn = elapsedTime - timeLeft;
+
+        firePlayerBullet(
+            player->position[0] + player->velocity[0] * timeIn + SPRITES_PLAYER_BULLET_X_OFFSET,
+            player->position[1] + player->velocity[1] * timeIn + SPRITES_PLAYER_BULLET_Y_OFFSET,
+            timeLeft
+        );
     }
 
     if (player->velocity[0] < -1.0f) {
@@ -605,7 +1068,7 @@ static void simPlayer(float elapsedTime) {
                 .y = player->position[1] + SPRITES_PLAYER_EXPLOSION_Y_OFFSET 
             });
 
-            platform_playSound(gameData.sounds.explosion, false);
+            playSoundAt(gameData.sounds.explosion, player->position[0]);
             player->position[0] = GAME_WIDTH / 2 - player->sprite->panelDims[0] / 2;
             player->position[1] = GAME_HEIGHT - player->sprite->panelDims[0] * 3.0f;
             player->deadTimer = PLAYER_DEAD_TIME;
@@ -621,8 +1084,6 @@ static void simPlayer(float elapsedTime) {
 //////////////////////////////////
 
 static void inputToStartScreen(float elapsedTime) {
-    platform_getInput(&gameState.input);
-    
     updateStars(elapsedTime);
 
     entities.text.count = 0;
@@ -651,8 +1112,6 @@ static void titleScreen(float elapsedTime) {
     events_beforeFrame(&events_subtitleSequence, elapsedTime);
     events_beforeFrame(&events_instructionSequence, elapsedTime);
 
-    platform_getInput(&gameState.input);
-    
     updateStars(elapsedTime);
 
     entities.text.count = 0;
@@ -743,7 +1202,15 @@ static void titleScreen(float elapsedTime) {
         events_stop(&events_subtitleSequence);
     }
 
-    if ((gameState.input.shoot && !gameState.input.lastShoot) || events_instructionSequence.complete) {
+    if (inputQueue.pressCount > 0 || events_instructionSequence.complete) {
+        // Normally done loading long before this. Uploads can't
+        // be waited for on the simulation thread, so sprites that
+        // aren't ready yet aren't drawn until they are.
+        if (!gameState.simulationThread && !waitForTextures(false) && !assetLoads.textureFailed) {
+            assetLoads.textureFailed = true;
+            platform_userMessage("Unable to load textures.");
+        }
+
         entities.text.count = 0;
         transitionLevel();
     }
@@ -802,7 +1269,10 @@ static void mainGame(float elapsedTime) {
 
     Player* player = &entities.player;
 
-    if (player->bulletThrottle > 0.0f) {
+    // Keeps counting for a tick past zero, so a press
+    // partway through a tick can tell whether the throttle
+    // had run out yet (see firePlayerBullet()).
+    if (player->bulletThrottle > -elapsedTime) {
         player->bulletThrottle -= elapsedTime; 
     }
 
@@ -840,8 +1310,6 @@ static void gameOver(float elapsedTime) {
     events_beforeFrame(&events_gameOverRestartSequence, elapsedTime);
     entities.text.count = 0;
 
-    platform_getInput(&gameState.input);
-
     simWorld(elapsedTime);
 
     entities_fromText(&entities.text, "Game Over", &(Entities_FromTextOptions) {
@@ -868,7 +1336,7 @@ static void gameOver(float elapsedTime) {
     updateAnimations();
     filterDeadEntities();
 
-    if (events_gameOverRestartSequence.running && gameState.input.shoot) {
+    if (events_gameOverRestartSequence.running && (gameState.input.shoot || inputQueue.pressCount > 0)) {
         entities.player.lives = PLAYER_NUM_LIVES;
         entities.player.score = 0;
         entities.player.deadTimer = 0.0f;
@@ -893,6 +1361,8 @@ static void gameOver(float elapsedTime) {
 //////////////////////////////////
 
 static void simulate(float elapsedTime) {
+    savePositions();
+    ++gameState.tick;
     gameState.animationTime += elapsedTime;
 
     switch(gameState.state) {
@@ -903,11 +1373,111 @@ static void simulate(float elapsedTime) {
         case GAME_OVER: gameOver(elapsedTime); break;
     }
 
+    if (gameState.input.time > gameState.inputTime) {
+        gameState.inputTime = gameState.input.time;
+    }
+
     if (gameState.animationTime > TIME_PER_ANIMATION) {
-        gameState.animationTime = 0.0f;
+        gameState.animationTime -= TIME_PER_ANIMATION;
     }
 }
 
+//////////////////////////////////
+//  Render snapshots
+//////////////////////////////////
+
+///////////////////////////////////////////////////////////
+// When the simulation runs on its own thread (see
+// game_simulate()), the draw lists are copied into a
+// snapshot after each batch of ticks and handed to
+// game_draw() through a triple buffer. The simulation
+// fills the back snapshot and swaps it into the middle,
+// and the draw swaps the middle for its front snapshot
+// whenever a newer one has been published. Neither side
+// ever waits on the other, and the draw always gets the
+// newest complete snapshot.
+// Reference:
+// - https://en.wikipedia.org/wiki/Multiple_buffering#Triple_buffering
+///////////////////////////////////////////////////////////
+
+#define NUM_SNAPSHOTS 3
+#define SNAPSHOT_INDEX_MASK 0x3
+#define SNAPSHOT_NEW 0x4 // Set on the middle index when it's been published but not drawn
+#define NUM_DRAW_LISTS 10
+#define DRAW_LIST_PLAYER 1
+
+typedef struct {
+    Renderer_List lists[NUM_DRAW_LISTS];
+    bool playerVisible;
+    float tickTime;
+    int64_t inputTime;
+} RenderSnapshot;
+
+// In draw order.
+static Renderer_List* drawLists[NUM_DRAW_LISTS] = {
+    &entities.stars.renderList,
+    &entities.player.renderList,
+    &entities.explosions.renderList,
+    &entities.smallEnemies.renderList,
+    &entities.mediumEnemies.renderList,
+    &entities.largeEnemies.renderList,
+    &entities.enemyBullets.renderList,
+    &entities.playerBullets.renderList,
+    &entities.text.renderList,
+    &entities.lives.renderList
+};
+
+static struct {
+    RenderSnapshot snapshots[NUM_SNAPSHOTS];
+    volatile int32_t middle;
+    int32_t back;  // Simulation thread only
+    int32_t front; // Drawing thread only
+    float drawTime; // Time since the front snapshot was published
+} renderSnapshots = {
+    .front = 0,
+    .middle = 1,
+    .back = 2
+};
+
+// Only the active part of each array is copied.
+static void copyRenderList(Renderer_List* dst, Renderer_List* src) {
+    int32_t count = src->count;
+
+    memcpy(dst->position, src->position, count * 2 * sizeof(float));
+    memcpy(dst->previousPosition, src->previousPosition, count * 2 * sizeof(float));
+    memcpy(dst->currentSpritePanel, src->currentSpritePanel, count * 2 * sizeof(float));
+    memcpy(dst->scale, src->scale, count * sizeof(float));
+    memcpy(dst->alpha, src->alpha, count * sizeof(float));
+    memcpy(dst->whiteOut, src->whiteOut, count * sizeof(float));
+    dst->sprite = src->sprite;
+    dst->count = count;
+}
+
+static void publishSnapshot(void) {
+    RenderSnapshot* snapshot = renderSnapshots.snapshots + renderSnapshots.back;
+
+    for (int32_t i = 0; i < NUM_DRAW_LISTS; ++i) {
+        copyRenderList(snapshot->lists + i, drawLists[i]);
+    }
+
+    snapshot->playerVisible = entities.player.deadTimer <= 0.0f;
+    snapshot->tickTime = gameState.tickTime;
+    snapshot->inputTime = gameState.inputTime;
+
+    renderSnapshots.back = utils_atomicExchange(&renderSnapshots.middle, renderSnapshots.back | SNAPSHOT_NEW) & SNAPSHOT_INDEX_MASK;
+}
+
+// Only the drawing thread clears SNAPSHOT_NEW, so it can't be
+// lost between the load and the exchange.
+static RenderSnapshot* acquireSnapshot(void) {
+    if (utils_atomicLoad(&renderSnapshots.middle) & SNAPSHOT_NEW) {
+        renderSnapshots.front = utils_atomicExchange(&renderSnapshots.middle, renderSnapshots.front) & SNAPSHOT_INDEX_MASK;
+        renderSnapshots.drawTime = renderSnapshots.snapshots[renderSnapshots.front].tickTime;
+    }
+
+    return renderSnapshots.snapshots + renderSnapshots.front;
+}
+
 //////////////////////////////////
 //  Platform interface functions
 //////////////////////////////////
@@ -916,47 +1486,67 @@ bool game_init(Game_InitOptions* opts) {
 
     gameState.state = TITLE_SCREEN;
 
+    int32_t tickRate = DEFAULT_TICK_RATE;
+
     if (opts) {
         gameState.hideSystemInstructions = opts->hideSystemInstructions;
+        gameState.simulationThread = opts->simulationThread;
 
         if (opts->showInputToStartScreen) {
             gameState.state = INPUT_TO_START_SCREEN;
         }
+
+        if (opts->tickRate >= MIN_TICK_RATE && opts->tickRate <= MAX_TICK_RATE) {
+            tickRate = opts->tickRate;
+        } else if (opts->tickRate != 0) {
+            DEBUG_LOG("game_init: Unsupported tick rate. Using the default.");
+        }
     }
 
+    gameState.tickDuration = 1000.0f / tickRate;
+
     // Init subsystems
     utils_init();
     
+    platform_startupPhase("renderer-init");
+
     if (!renderer_init(GAME_WIDTH, GAME_HEIGHT)) {
         platform_userMessage("FATAL ERROR: Unable to initialize renderer.");
         return false;
     }
 
-    // Load assets
-    if (
-        !loadTexture("assets/sprites/ship.bmp", &sprites_player.texture) ||
-        !loadTexture("assets/sprites/enemy-small.bmp", &sprites_smallEnemy.texture) ||
-        !loadTexture("assets/sprites/enemy-medium.bmp", &sprites_mediumEnemy.texture) ||
-        !loadTexture("assets/sprites/enemy-big.bmp", &sprites_largeEnemy.texture) ||
-        !loadTexture("assets/sprites/explosion.bmp", &sprites_explosion.texture) ||
-        !loadTexture("assets/sprites/pixelspritefont32.bmp", &sprites_text.texture) ||
-        !loadTexture("assets/sprites/laser-bolts.bmp", &sprites_playerBullet.texture)
-    ) {
-        platform_userMessage("FATAL ERROR: Unable to load textures.");
-        return false;
+    //////////////////////////////////////////////////////
+    // Load assets. Only the title screen's textures are
+    // waited for here. The rest are uploaded by
+    // game_update() as they finish decoding.
+    //////////////////////////////////////////////////////
+
+    platform_startupPhase("start-texture-jobs");
+    startTextureLoads();
+
+    platform_startupPhase("animations");
+    for (int32_t i = 0; i < NUM_ANIMATION_LOADS; ++i) {
+        if (!loadAnimations(assetLoads.animations + i)) {
+            platform_userMessage("FATAL ERROR: Unable to load animations.");
+            return false;
+        }
     }
 
-    sprites_whitePixel.texture = renderer_createTexture(gameData.whitePixel, 1, 1);
+    if (!opts || !opts->noAudio) {
+        platform_startupPhase("game-init-audio");
+        game_initAudio();
+    }
 
-    // Shared texture    
-    sprites_enemyBullet.texture = sprites_playerBullet.texture;
+    platform_startupPhase("title-textures");
+    sprites_whitePixel.texture = renderer_createTexture(gameData.whitePixel, 1, 1);
 
-    if (!renderer_validate()) {
-        platform_userMessage("FATAL ERROR: Unable to allocate textures.");
+    if (!renderer_validate() || !waitForTextures(true)) {
+        platform_userMessage("FATAL ERROR: Unable to load textures.");
         return false;
     }
 
     // Init game
+    platform_startupPhase("game-state");
     entities_spawn(&entities.player.entity, &(Entities_InitOptions) {
         .x = (GAME_WIDTH - entities.player.sprite->panelDims[0]) / 2,
         .y = GAME_HEIGHT - entities.player.sprite->panelDims[1] * 2.0f
@@ -980,38 +1570,35 @@ bool game_init(Game_InitOptions* opts) {
 
     events_start(&events_titleControlSequence);
 
-    if (!opts || !opts->noAudio) {
-        game_initAudio();
+    // So there's something to draw before the first tick.
+    if (gameState.simulationThread) {
+        publishSnapshot();
     }
 
     return true;
 }
 
+// Sounds become playable (and the music starts) as their
+// loads complete in game_update().
 void game_initAudio(void) {
-    gameData.sounds.music = platform_loadSound("assets/audio/music.wav");
-    gameData.sounds.playerBullet = platform_loadSound("assets/audio/Laser_002.wav");
-    gameData.sounds.enemyBullet = platform_loadSound("assets/audio/Hit_Hurt2.wav");
-    gameData.sounds.explosion = platform_loadSound("assets/audio/Explode1.wav");
-    gameData.sounds.enemyHit = platform_loadSound("assets/audio/Jump1.wav");
-
-    if (
-        gameData.sounds.music == -1 ||
-        gameData.sounds.playerBullet == -1 ||
-        gameData.sounds.enemyBullet == -1 ||
-        gameData.sounds.explosion == -1 ||
-        gameData.sounds.enemyHit == -1
-    ) {
-        platform_userMessage("Unable to load all audio.");
+    for (int32_t i = 0; i < NUM_SOUND_LOADS; ++i) {
+        SoundLoad* load = assetLoads.sounds + i;
+        load->pending = true;
+        load->job = startJob(loadSoundJob, load);
     }
 
-    platform_playSound(gameData.sounds.music, true);
-
     gameState.state = TITLE_SCREEN;
 }
 
 ////////////////////////////////////////////////////////////
-// Fixed time step + sim any time left at
-// end of frame. 
+// Fixed time step. Time left over at the end of a frame
+// carries over to the next, and game_draw() interpolates
+// positions by how far into the next tick it is, so the
+// simulation is the same at any display rate. Everything
+// in the simulation is scaled by elapsed time (velocities
+// and timers are per millisecond, and spawn and fire
+// probabilities are per millisecond, checked once a tick),
+// so the tick rate only changes how finely it's sampled.
 // References:
 // - https://www.gafferongames.com/post/fix_your_timestep/
 // - https://www.youtube.com/watch?v=jTzIDmjkLQo
@@ -1019,20 +1606,124 @@ void game_initAudio(void) {
 ////////////////////////////////////////////////////////////
 
 void game_update(float elapsedTime) {
-    if (elapsedTime > 33.3f) {
-        elapsedTime = 33.3f;
+    if (elapsedTime > MAX_ELAPSED_TIME) {
+        elapsedTime = MAX_ELAPSED_TIME;
     }
 
+    updateTextureLoads();
+
+    if (gameState.simulationThread) {
+        renderSnapshots.drawTime += elapsedTime;
+    } else {
+        updateSoundLoads();
+
+        gameState.tickTime += elapsedTime;
+
+        if (gameState.tickTime >= gameState.tickDuration) {
+            pollInput();
+        }
+
+        while (gameState.tickTime >= gameState.tickDuration) {
+            updateTickInput();
+            simulate(gameState.tickDuration);    
+            gameState.tickTime -= gameState.tickDuration;
+        }
+    }
+
+#ifdef SPACE_SHOOTER_DEBUG
+    logAudioStats();
+#endif
+}
+
+// Runs on the platform's simulation thread, so nothing here
+// can touch GL or the front render snapshot.
+float game_simulate(float elapsedTime) {
+    if (elapsedTime > MAX_ELAPSED_TIME) {
+        elapsedTime = MAX_ELAPSED_TIME;
+    }
+
+    updateSoundLoads();
+    updateAnimationReloads();
+
     gameState.tickTime += elapsedTime;
 
-    if (gameState.tickTime > TICK_DURATION) {
-        while (gameState.tickTime > TICK_DURATION) {
-            simulate(TICK_DURATION);    
-            gameState.tickTime -= TICK_DURATION;
+    bool ticked = false;
+
+    if (gameState.tickTime >= gameState.tickDuration) {
+        pollInput();
+    }
+
+    while (gameState.tickTime >= gameState.tickDuration) {
+        updateTickInput();
+        simulate(gameState.tickDuration);
+        gameState.tickTime -= gameState.tickDuration;
+        ticked = true;
+    }
+
+    if (ticked) {
+        publishSnapshot();
+    }
+
+    return gameState.tickDuration - gameState.tickTime;
+}
+
+void game_reloadAsset(const char* fileName) {
+    size_t length = strlen(fileName);
+
+    if (length > 5 && strcmp(fileName + length - 5, ".glsl") == 0) {
+        if (!renderer_reloadShaders()) {
+            DEBUG_LOG("game_reloadAsset: Unable to reload shaders.");
         }
 
-        simulate(gameState.tickTime);
-        gameState.tickTime = 0.0f;
+        return;
+    }
+
+    for (int32_t i = 0; i < NUM_ANIMATION_LOADS; ++i) {
+        AnimationLoad* load = assetLoads.animations + i;
+
+        if (strcmp(fileName, load->fileName) != 0) {
+            continue;
+        }
+
+        if (gameState.simulationThread) {
+            utils_atomicExchange(&load->reloadPending, 1);
+            return;
+        }
+
+        if (!loadAnimations(load)) {
+            DEBUG_LOG("game_reloadAsset: Unable to reload animations.");
+        }
+
+        return;
+    }
+
+    for (int32_t i = 0; i < NUM_TEXTURE_LOADS; ++i) {
+        TextureLoad* load = assetLoads.textures + i;
+
+        // Still loading, so the new version will be picked up anyway.
+        if (load->pending || strcmp(fileName, load->fileName) != 0) {
+            continue;
+        }
+
+        Data_Image image = { 0 };
+
+        if (!utils_loadBmpData(fileName, &image)) {
+            DEBUG_LOG("game_reloadAsset: Unable to reload texture.");
+            return;
+        }
+
+        uint32_t oldTexture = load->sprite->texture;
+        uint32_t oldPalette = load->sprite->palette;
+        uploadTexture(load, &image);
+        data_freeImage(&image);
+
+        renderer_deleteTexture(oldTexture);
+
+        if (oldPalette) {
+            renderer_deleteTexture(oldPalette);
+        }
+
+        return;
     }
 }
 
@@ -1041,26 +1732,55 @@ void game_resize(int width, int height) {
     game_draw();
 }
 
+// With a simulation thread, the newest snapshot is drawn,
+// interpolated by the time since it was published (capped
+// at a full tick if the simulation falls behind).
 void game_draw(void) {
     renderer_beforeFrame();
 
-    renderer_draw(&entities.stars.renderList);
+    if (gameState.simulationThread) {
+        RenderSnapshot* snapshot = acquireSnapshot();
+        float alpha = renderSnapshots.drawTime / gameState.tickDuration;
 
-    if (entities.player.deadTimer <= 0.0f) {
-        renderer_draw(&entities.player.renderList);
+        if (alpha > 1.0f) {
+            alpha = 1.0f;
+        }
+
+        for (int32_t i = 0; i < NUM_DRAW_LISTS; ++i) {
+            if (i != DRAW_LIST_PLAYER || snapshot->playerVisible) {
+                renderer_draw(snapshot->lists + i, alpha);
+            }
+        }
+
+        gameState.drawnInputTime = snapshot->inputTime;
+
+        return;
+    }
+
+    float alpha = gameState.tickTime / gameState.tickDuration;
+    gameState.drawnInputTime = gameState.inputTime;
+
+    for (int32_t i = 0; i < NUM_DRAW_LISTS; ++i) {
+        if (i != DRAW_LIST_PLAYER || entities.player.deadTimer <= 0.0f) {
+            renderer_draw(drawLists[i], alpha);
+        }
     }
+}
 
-    renderer_draw(&entities.explosions.renderList);
-    renderer_draw(&entities.smallEnemies.renderList);
-    renderer_draw(&entities.mediumEnemies.renderList);
-    renderer_draw(&entities.largeEnemies.renderList);
-    renderer_draw(&entities.enemyBullets.renderList);
-    renderer_draw(&entities.playerBullets.renderList);
-    renderer_draw(&entities.text.renderList);
-    renderer_draw(&entities.lives.renderList);
+int64_t game_drawnInputTime(void) {
+    return gameState.drawnInputTime;
 }
 
+// Jobs must be stopped by the platform layer before this is called.
 void game_close(void) {
+    for (int32_t i = 0; i < NUM_TEXTURE_LOADS; ++i) {
+        data_freeImage(&assetLoads.textures[i].image);
+    }
+
+    for (int32_t i = 0; i < NUM_ANIMATION_LOADS; ++i) {
+        data_freeAnimations(&assetLoads.animations[i].sprite->animations);
+    }
+
     data_freeBuffer(&gameData.soundData.music);
     data_freeBuffer(&gameData.soundData.playerBullet);
     data_freeBuffer(&gameData.soundData.enemyBullet);
@@ -32,6 +32,7 @@
 #endif
 
 #include <malloc.h>
+#include <string.h>
 #include "renderer.h"
 #include "../shared/data.h"
 #include "../shared/platform-interface.h"
@@ -54,6 +55,7 @@ static struct {
 static struct {
     GLuint panelIndex;
     GLuint pixelOffset;
+    GLuint previousPixelOffset;
     GLuint scale;
     GLuint whiteOut;
     GLuint alpha;
@@ -64,60 +66,60 @@ static struct {
     GLuint spriteSheet;
     GLuint panelPixelSize;
     GLuint spriteSheetDimensions;
+    GLuint indexed;
+    GLuint interpolation;
 } uniforms;
 
-bool renderer_init(int worldWidth, int worldHeight) {
-    game.worldWidth = worldWidth;
-    game.worldHeight = worldHeight;
+static GLuint program;
 
-    glEnable(GL_SCISSOR_TEST);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
-    glActiveTexture(GL_TEXTURE0);
+static GLuint compileShader(GLenum type, const char* fileName, const char* preamble) {
+    Data_Buffer source = { 0 };
 
-    Data_Buffer vsSource = { 0 };
-    Data_Buffer fsSource = { 0 };
+    ///////////////////////////////////////////////////////
+    // Shader sources are views that aren't null-terminated,
+    // so their lengths are passed explicitly (-1 marks the
+    // null-terminated preamble).
+    ///////////////////////////////////////////////////////
 
-    if (!platform_loadFile("assets/shaders/vs.glsl", &vsSource, true)) {
-        DEBUG_LOG("renderer_init: Unable to load vertex shader.");
-        return false;
+    if (!platform_mapFile(fileName, &source)) {
+        DEBUG_LOG("renderer_compileShader: Unable to load shader.");
+        return 0;
     }
 
-    const char* vertexShaderParts[2] = {
-        VS_PREAMBLE,
-        (const char*) vsSource.data
+    const char* shaderParts[2] = {
+        preamble,
+        (const char*) source.data
     };
+    GLint shaderLengths[2] = { -1, (GLint) source.size };
 
-    GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertexShader, 2, vertexShaderParts, NULL);
-    glCompileShader(vertexShader);
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 2, shaderParts, shaderLengths);
+    glCompileShader(shader);
 
-    data_freeBuffer(&vsSource);
+    data_freeBuffer(&source);
 
-    if (!platform_loadFile("assets/shaders/fs.glsl", &fsSource, true)) {
-        DEBUG_LOG("renderer_init: Unable to load fragment shader.");
-        return false;
-    }
+    return shader;
+}
 
-    const char* fragmentShaderParts[2] = {
-        FS_PREAMBLE,
-        (const char*) fsSource.data
-    };
-        
-    GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragmentShader, 2, fragmentShaderParts, NULL);
-    glCompileShader(fragmentShader);
+// Returns 0 if the program couldn't be built.
+static GLuint createProgram(void) {
+    GLuint vertexShader = compileShader(GL_VERTEX_SHADER, "assets/shaders/vs.glsl", VS_PREAMBLE);
+    GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, "assets/shaders/fs.glsl", FS_PREAMBLE);
 
-    data_freeBuffer(&fsSource);
-    
-    GLuint program = glCreateProgram();
-    glAttachShader(program, vertexShader);
-    glAttachShader(program, fragmentShader);
-    glLinkProgram(program);
+    if (!vertexShader || !fragmentShader) {
+        glDeleteShader(vertexShader);
+        glDeleteShader(fragmentShader);
+        return 0;
+    }
+
+    GLuint newProgram = glCreateProgram();
+    glAttachShader(newProgram, vertexShader);
+    glAttachShader(newProgram, fragmentShader);
+    glLinkProgram(newProgram);
 
 
     GLint result;
-    glGetProgramiv(program, GL_LINK_STATUS, &result);
+    glGetProgramiv(newProgram, GL_LINK_STATUS, &result);
 
     if (result != GL_TRUE) {
 #ifdef SPACE_SHOOTER_DEBUG
@@ -137,18 +139,53 @@ bool renderer_init(int worldWidth, int worldHeight) {
         }
 #endif
 
-        return false;
+        glDeleteProgram(newProgram);
+        newProgram = 0;
     }
 
+    // Shaders are only flagged for deletion while attached.
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+
+    return newProgram;
+}
+
+static void useProgram(GLuint newProgram) {
+    program = newProgram;
     glUseProgram(program);
 
     uniforms.panelPixelSize = glGetUniformLocation(program, "panelPixelSize");
     uniforms.spriteSheetDimensions = glGetUniformLocation(program, "spriteSheetDimensions");
+    uniforms.indexed = glGetUniformLocation(program, "indexed");
+    uniforms.interpolation = glGetUniformLocation(program, "interpolation");
     GLuint pixelClipSizeUniform = glGetUniformLocation(program, "pixelClipSize");
     GLuint spriteSheetUniform = glGetUniformLocation(program, "spriteSheet");
+    GLuint paletteUniform = glGetUniformLocation(program, "palette");
 
-    glUniform2f(pixelClipSizeUniform, 2.0f / worldWidth, 2.0f / worldHeight);
+    glUniform2f(pixelClipSizeUniform, 2.0f / game.worldWidth, 2.0f / game.worldHeight);
     glUniform1i(spriteSheetUniform, 0);
+    glUniform1i(paletteUniform, 1);
+}
+
+bool renderer_init(int worldWidth, int worldHeight) {
+    game.worldWidth = worldWidth;
+    game.worldHeight = worldHeight;
+
+    glEnable(GL_SCISSOR_TEST);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    glActiveTexture(GL_TEXTURE0);
+
+    // Index textures have 1-byte rows.
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    GLuint newProgram = createProgram();
+
+    if (!newProgram) {
+        return false;
+    }
+
+    useProgram(newProgram);
 
     float positions[] = {
         0.0f, 0.0f,
@@ -210,14 +247,21 @@ bool renderer_init(int worldWidth, int worldHeight) {
     glVertexAttribDivisor(5, 1);
     glEnableVertexAttribArray(5);
 
+    glGenBuffers(1, &buffers.previousPixelOffset);
+    glBindBuffer(GL_ARRAY_BUFFER, buffers.previousPixelOffset);
+    glBufferData(GL_ARRAY_BUFFER, RENDERER_DRAWLIST_MAX * 2 * sizeof(float), NULL, GL_DYNAMIC_DRAW);
+    glVertexAttribPointer(6, 2, GL_FLOAT, GL_FALSE, 0, NULL);
+    glVertexAttribDivisor(6, 1);
+    glEnableVertexAttribArray(6);
+
     return renderer_validate();
 }
 
-uint32_t renderer_createTexture(uint8_t* data, int32_t width, int32_t height) {
+static uint32_t createTexture(GLint internalFormat, GLenum format, uint8_t* data, int32_t width, int32_t height) {
     uint32_t texture;
     glGenTextures(1, &texture);
     glBindTexture(GL_TEXTURE_2D, texture);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, format, GL_UNSIGNED_BYTE, data);
 
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
@@ -227,10 +271,60 @@ uint32_t renderer_createTexture(uint8_t* data, int32_t width, int32_t height) {
     return texture;
 }
 
+uint32_t renderer_createTexture(uint8_t* data, int32_t width, int32_t height) {
+    return createTexture(GL_RGBA, GL_RGBA, data, width, height);
+}
+
+uint32_t renderer_createIndexedTexture(uint8_t* indices, int32_t width, int32_t height) {
+    return createTexture(GL_R8, GL_RED, indices, width, height);
+}
+
+///////////////////////////////////////////////////////
+// Palettes are stored as 2-row textures. The first
+// row holds the sprite's colors, and the second the
+// same colors turned white (keeping their alpha) for
+// the whiteOut flash, so it's just a palette swap in
+// the fragment shader.
+///////////////////////////////////////////////////////
+
+uint32_t renderer_createPalette(uint8_t* colors) {
+    uint8_t rows[DATA_PALETTE_SIZE * 4 * 2];
+    uint8_t* whiteRow = rows + DATA_PALETTE_SIZE * 4;
+
+    memcpy(rows, colors, DATA_PALETTE_SIZE * 4);
+
+    for (int32_t i = 0; i < DATA_PALETTE_SIZE; ++i) {
+        whiteRow[i * 4]     = 255;
+        whiteRow[i * 4 + 1] = 255;
+        whiteRow[i * 4 + 2] = 255;
+        whiteRow[i * 4 + 3] = colors[i * 4 + 3];
+    }
+
+    return createTexture(GL_RGBA, GL_RGBA, rows, DATA_PALETTE_SIZE, 2);
+}
+
+void renderer_deleteTexture(uint32_t texture) {
+    glDeleteTextures(1, &texture);
+}
+
 bool renderer_validate(void) {
     return glGetError() != GL_OUT_OF_MEMORY;
 }
 
+bool renderer_reloadShaders(void) {
+    GLuint newProgram = createProgram();
+
+    // Keep drawing with the old program if the new one is broken.
+    if (!newProgram) {
+        return false;
+    }
+
+    glDeleteProgram(program);
+    useProgram(newProgram);
+
+    return true;
+}
+
 
 void renderer_resize(int32_t width, int32_t height) {
     window.width = width;
@@ -261,18 +355,32 @@ void renderer_beforeFrame(void) {
     glClear(GL_COLOR_BUFFER_BIT);
 }
 
-void renderer_draw(Renderer_List* list) {
-    if (list->count == 0) {
+void renderer_draw(Renderer_List* list, float interpolation) {
+    // Textures may still be loading (e.g. when the level starts
+    // on the simulation thread), and an incomplete texture
+    // would draw the sprites as black quads.
+    if (list->count == 0 || list->sprite->texture == 0) {
         return;
     }
 
+    if (list->sprite->palette) {
+        glActiveTexture(GL_TEXTURE1);
+        glBindTexture(GL_TEXTURE_2D, list->sprite->palette);
+        glActiveTexture(GL_TEXTURE0);
+    }
+
     glBindTexture(GL_TEXTURE_2D, list->sprite->texture);
+    glUniform1i(uniforms.indexed, list->sprite->palette != 0);
+    glUniform1f(uniforms.interpolation, interpolation);
     glUniform2fv(uniforms.panelPixelSize, 1, list->sprite->panelDims);
     glUniform2fv(uniforms.spriteSheetDimensions, 1, list->sprite->sheetDims);
 
     glBindBuffer(GL_ARRAY_BUFFER, buffers.pixelOffset);
     glBufferSubData(GL_ARRAY_BUFFER, 0, list->count * 2 * sizeof(float), list->position);
 
+    glBindBuffer(GL_ARRAY_BUFFER, buffers.previousPixelOffset);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, list->count * 2 * sizeof(float), list->previousPosition);
+
     glBindBuffer(GL_ARRAY_BUFFER, buffers.panelIndex);
     glBufferSubData(GL_ARRAY_BUFFER, 0, list->count * 2 * sizeof(float), list->currentSpritePanel);
 
@@ -38,6 +38,8 @@
 // 
 // Members:
 // - position: pixel position of top-left corner of the entity
+// - previousPosition: position at the start of the last simulation
+//      tick, used to interpolate positions between ticks when drawing
 // - currentSpritePanel: 2D index of current sprite panel
 // - scale: multiplicative scaling factor for entity sprite
 // - alpha: blending alpha
@@ -50,6 +52,7 @@
 
 #define RENDERER_LIST_BODY {\
     float position[RENDERER_DRAWLIST_MAX * 2];\
+    float previousPosition[RENDERER_DRAWLIST_MAX * 2];\
     float currentSpritePanel[RENDERER_DRAWLIST_MAX * 2];\
     float scale[RENDERER_DRAWLIST_MAX];\
     float alpha[RENDERER_DRAWLIST_MAX];\
@@ -66,19 +69,34 @@ typedef struct RENDERER_LIST_BODY Renderer_List;
 // Renderer lifecycle functions.
 //
 // - renderer_init(): Initialize OpenGL resources.
-// - renderer_createTexture(): Create a texture from the provided data.
+// - renderer_createTexture(): Create a texture from the provided RGBA data.
+// - renderer_createIndexedTexture(): Create a texture from one palette
+//      index per pixel (see Data_Image). Drawn using the sprite's palette.
+// - renderer_createPalette(): Create a palette texture from
+//      DATA_PALETTE_SIZE RGBA colors.
+// - renderer_deleteTexture(): Delete a texture created by any of
+//      the functions above.
 // - renderer_validate(): Check that the OpenGL context isn't out of memory.
+// - renderer_reloadShaders(): Rebuild the shader program from the shader
+//      files (used for hot reloading). The current program is kept if
+//      the new one fails to build.
 // - renderer_resize(): Resize the viewport.
 // - renderer_beforeFrame(): Prepare for a frame (fixes aspect ratio
 //      and draws borders if necessary).
-// - renderer_draw(): Draw the Renderer_List to the screen.
+// - renderer_draw(): Draw the Renderer_List to the screen, with positions
+//      interpolated from previousPosition to position by `interpolation`
+//      (0 to 1). Lists whose sprite has no texture yet are skipped.
 //////////////////////////////////////////////////////////////////////////////
 
 bool renderer_init(int width, int height);
 uint32_t renderer_createTexture(uint8_t* data, int32_t width, int32_t height);
+uint32_t renderer_createIndexedTexture(uint8_t* indices, int32_t width, int32_t height);
+uint32_t renderer_createPalette(uint8_t* colors);
+void renderer_deleteTexture(uint32_t texture);
 bool renderer_validate(void);
+bool renderer_reloadShaders(void);
 void renderer_resize(int width, int height);
 void renderer_beforeFrame(void);
-void renderer_draw(Renderer_List* list);
+void renderer_draw(Renderer_List* list, float interpolation);
 
 #endif
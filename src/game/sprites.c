@@ -52,146 +52,13 @@ int32_t sprites_charToAnimationIndex(char c) {
     return -1;
 }
 
-static Sprites_Animation playerAnimations[]  = {
-    // Center
-    {
-        .frames = {{2.0f, 0.0f}, {2.0f, 1.0f}},
-        .numFrames = 2
-    },
-    // Center left
-    {
-        .frames = {{1.0f, 0.0f}, {1.0f, 1.0f}},
-        .numFrames = 2
-    },
-    // Left
-    {
-        .frames = {{0.0f, 0.0f}, {0.0f, 1.0f}},
-        .numFrames = 2
-    },
-    // Center right
-    {
-        .frames = {{3.0f, 0.0f}, {3.0f, 1.0f}},
-        .numFrames = 2
-    },
-    // Right
-    {
-        .frames = {{4.0f, 0.0f}, {4.0f, 1.0f}},
-        .numFrames = 2
-    }
-};
-
-static Sprites_Animation playerBulletAnimations[]  = {
-    {
-        .frames = {{0.0f, 1.0f}, {1.0f, 1.0f}},
-        .numFrames = 2
-    }
-};
-
-static Sprites_Animation enemyAnimations[]  = {
-    {
-        .frames = {{0.0f, 0.0f}, {1.0f, 0.0f}},
-        .numFrames = 2
-    }
-};
-
-static Sprites_Animation enemyBulletAnimations[]  = {
-    {
-        .frames = {{0.0f, 0.0f}, {1.0f, 0.0f}},
-        .numFrames = 2
-    }
-};
-
-static Sprites_Animation explosionAnimations[]  = {
-    {
-        .frames = {{0.0f, 0.0f}, {1.0f, 0.0f}, {2.0f, 0.0f}, {3.0f, 0.0f}, {4.0f, 0.0f}},
-        .numFrames = 5,
-        .endBehavior = SPRITES_ANIMATION_END_KILL
-    }
-};
-
-static Sprites_Animation fontAnimations[]  = {
-    { .frames = {{0.0f, 0.0f}}, .numFrames = 1},
-    { .frames = {{1.0f, 0.0f}}, .numFrames = 1},
-    { .frames = {{2.0f, 0.0f}}, .numFrames = 1},
-    { .frames = {{3.0f, 0.0f}}, .numFrames = 1},
-    { .frames = {{4.0f, 0.0f}}, .numFrames = 1},
-    { .frames = {{0.0f, 1.0f}}, .numFrames = 1},
-    { .frames = {{1.0f, 1.0f}}, .numFrames = 1},
-    { .frames = {{2.0f, 1.0f}}, .numFrames = 1},
-    { .frames = {{3.0f, 1.0f}}, .numFrames = 1},
-    { .frames = {{4.0f, 1.0f}}, .numFrames = 1},
-    { .frames = {{0.0f, 2.0f}}, .numFrames = 1},
-    { .frames = {{1.0f, 2.0f}}, .numFrames = 1},
-    { .frames = {{2.0f, 2.0f}}, .numFrames = 1},
-    { .frames = {{3.0f, 2.0f}}, .numFrames = 1},
-    { .frames = {{4.0f, 2.0f}}, .numFrames = 1},
-    { .frames = {{0.0f, 3.0f}}, .numFrames = 1},
-    { .frames = {{1.0f, 3.0f}}, .numFrames = 1},
-    { .frames = {{2.0f, 3.0f}}, .numFrames = 1},
-    { .frames = {{3.0f, 3.0f}}, .numFrames = 1},
-    { .frames = {{4.0f, 3.0f}}, .numFrames = 1},
-    { .frames = {{0.0f, 4.0f}}, .numFrames = 1},
-    { .frames = {{1.0f, 4.0f}}, .numFrames = 1},
-    { .frames = {{2.0f, 4.0f}}, .numFrames = 1},
-    { .frames = {{3.0f, 4.0f}}, .numFrames = 1},
-    { .frames = {{4.0f, 4.0f}}, .numFrames = 1},
-    { .frames = {{0.0f, 5.0f}}, .numFrames = 1},
-    { .frames = {{1.0f, 5.0f}}, .numFrames = 1},
-    { .frames = {{2.0f, 5.0f}}, .numFrames = 1},
-    { .frames = {{3.0f, 5.0f}}, .numFrames = 1},
-    { .frames = {{4.0f, 5.0f}}, .numFrames = 1},
-    { .frames = {{0.0f, 6.0f}}, .numFrames = 1},
-    { .frames = {{1.0f, 6.0f}}, .numFrames = 1},
-    { .frames = {{2.0f, 6.0f}}, .numFrames = 1},
-    { .frames = {{3.0f, 6.0f}}, .numFrames = 1},
-    { .frames = {{4.0f, 6.0f}}, .numFrames = 1},
-    { .frames = {{0.0f, 7.0f}}, .numFrames = 1},
-    { .frames = {{1.0f, 7.0f}}, .numFrames = 1},
-    { .frames = {{2.0f, 7.0f}}, .numFrames = 1},
-    { .frames = {{3.0f, 7.0f}}, .numFrames = 1},
-    { .frames = {{4.0f, 7.0f}}, .numFrames = 1},
-    { .frames = {{0.0f, 8.0f}}, .numFrames = 1},
-    { .frames = {{1.0f, 8.0f}}, .numFrames = 1},
-    { .frames = {{2.0f, 8.0f}}, .numFrames = 1},
-    { .frames = {{3.0f, 8.0f}}, .numFrames = 1},
-    { .frames = {{4.0f, 8.0f}}, .numFrames = 1},
-    { .frames = {{0.0f, 9.0f}}, .numFrames = 1},
-    { .frames = {{1.0f, 9.0f}}, .numFrames = 1},
-    { .frames = {{2.0f, 9.0f}}, .numFrames = 1},
-    { .frames = {{3.0f, 9.0f}}, .numFrames = 1},
-    { .frames = {{4.0f, 9.0f}}, .numFrames = 1},
-    { .frames = {{0.0f, 10.0f}}, .numFrames = 1},
-    { .frames = {{1.0f, 10.0f}}, .numFrames = 1},
-    { .frames = {{2.0f, 10.0f}}, .numFrames = 1},
-    { .frames = {{3.0f, 10.0f}}, .numFrames = 1},
-    { .frames = {{4.0f, 10.0f}}, .numFrames = 1},
-    { .frames = {{0.0f, 11.0f}}, .numFrames = 1},
-    { .frames = {{1.0f, 11.0f}}, .numFrames = 1},
-    { .frames = {{2.0f, 11.0f}}, .numFrames = 1},
-    { .frames = {{3.0f, 11.0f}}, .numFrames = 1},
-    { .frames = {{4.0f, 11.0f}}, .numFrames = 1},
-    { .frames = {{0.0f, 12.0f}}, .numFrames = 1},
-    { .frames = {{1.0f, 12.0f}}, .numFrames = 1},
-    { .frames = {{2.0f, 12.0f}}, .numFrames = 1},
-    { .frames = {{3.0f, 12.0f}}, .numFrames = 1},
-    { .frames = {{4.0f, 12.0f}}, .numFrames = 1},
-    { .frames = {{0.0f, 13.0f}}, .numFrames = 1},
-    { .frames = {{1.0f, 13.0f}}, .numFrames = 1},
-    { .frames = {{2.0f, 13.0f}}, .numFrames = 1},
-    { .frames = {{3.0f, 13.0f}}, .numFrames = 1},
-    { .frames = {{4.0f, 13.0f}}, .numFrames = 1}    
-
-};
-
 Sprites_Sprite sprites_player = {
     .panelDims = { SPRITES_PLAYER_PANEL_WIDTH, SPRITES_PLAYER_PANEL_HEIGHT },
     .sheetDims = { 5.0f, 2.0f },
     .collisionBox = {
         .min = {0.0f, 0.0f},
         .max = {16.0f, 15.0f}
-    },
-    .animations = playerAnimations,
-    .numAnimations = sizeof(playerAnimations) / sizeof(playerAnimations[0])
+    }
 };
 
 Sprites_Sprite sprites_smallEnemy = {
@@ -200,9 +67,7 @@ Sprites_Sprite sprites_smallEnemy = {
     .collisionBox = {
         .min = {0.0f, 5.0f},
         .max = {16.0f, 16.0f}
-    },
-    .animations = enemyAnimations,
-    .numAnimations = sizeof(enemyAnimations) / sizeof(enemyAnimations[0])
+    }
 };
 
 Sprites_Sprite sprites_mediumEnemy = {
@@ -211,9 +76,7 @@ Sprites_Sprite sprites_mediumEnemy = {
     .collisionBox = {
         .min = {0.0f, 0.0f},
         .max = {32.0f, 16.0f}
-    },
-    .animations = enemyAnimations,
-    .numAnimations = sizeof(enemyAnimations) / sizeof(enemyAnimations[0])
+    }
 };
 
 Sprites_Sprite sprites_largeEnemy = {
@@ -222,9 +85,7 @@ Sprites_Sprite sprites_largeEnemy = {
     .collisionBox = {
         .min = {3.0f, 12.0f},
         .max = {29.0f, 32.0f}
-    },
-    .animations = enemyAnimations,
-    .numAnimations = sizeof(enemyAnimations) / sizeof(enemyAnimations[0])
+    }
 };
 
 Sprites_Sprite sprites_playerBullet = {
@@ -233,9 +94,7 @@ Sprites_Sprite sprites_playerBullet = {
     .collisionBox = {
         .min = {4.0f, 2.0f},
         .max = {11.0f, 15.0f}
-    },
-    .animations = playerBulletAnimations,
-    .numAnimations = sizeof(playerBulletAnimations) / sizeof(playerBulletAnimations[0])
+    }
 };
 
 Sprites_Sprite sprites_enemyBullet = {
@@ -244,23 +103,17 @@ Sprites_Sprite sprites_enemyBullet = {
     .collisionBox = {
         .min = {4.0f, 7.0f},
         .max = {11.0f, 12.0f}
-    },
-    .animations = enemyBulletAnimations,
-    .numAnimations = sizeof(enemyBulletAnimations) / sizeof(enemyBulletAnimations[0])
+    }
 };
 
 Sprites_Sprite sprites_explosion = {
     .panelDims = { SPRITES_EXPLOSION_PANEL_WIDTH, SPRITES_EXPLOSION_PANEL_HEIGHT },
     .sheetDims = { 5.0f, 1.0f },
-    .animations = explosionAnimations,
-    .numAnimations = sizeof(explosionAnimations) / sizeof(explosionAnimations[0])
 };
 
 Sprites_Sprite sprites_text = {
     .panelDims = { SPRITES_TEXT_PANEL_WIDTH, SPRITES_TEXT_PANEL_HEIGHT },
     .sheetDims = { 5.0f, 13.0f },
-    .animations = fontAnimations,
-    .numAnimations = sizeof(fontAnimations) / sizeof(fontAnimations[0])
 };
 
 Sprites_Sprite sprites_whitePixel = {
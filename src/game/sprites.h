@@ -30,6 +30,7 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include "../shared/data.h"
 
 //////////////////
 // Animations
@@ -41,6 +42,15 @@
 #define SPRITES_PLAYER_CENTER_RIGHT 3
 #define SPRITES_PLAYER_RIGHT        4
 
+/////////////////////////////////////////////////////
+// Number of animations the game expects in each
+// sprite's animation file. Font glyphs are indexed
+// by sprites_charToAnimationIndex().
+/////////////////////////////////////////////////////
+
+#define SPRITES_PLAYER_NUM_ANIMATIONS 5
+#define SPRITES_TEXT_NUM_ANIMATIONS   65
+
 
 //////////////////////////////////
 // Sprite sheet panel dimensions
@@ -103,13 +113,15 @@
 // Members:
 // - collisionBox: bounds of the actual image with the sprite panel.
 //      Used in collision detection.
-// - animations: array of animations available in the sprite sheet. 
-//      Each animation is an array of 2D indices into the sprite
-//      sheet indicating the frames of the animation.
+// - animations: table of animations available in the sprite sheet,
+//      loaded from its animation file. Each animation is a range of
+//      2D indices into the sprite sheet indicating the frames of the
+//      animation.
 // - sheetDims: dimensions of the sprite sheet in panels.
 // - panelDims: dimensions of each panel in pixels.
-// - numAnimations: length of the animations array.
 // - texture: handle to the OpenGL texture containing the sprite sheet.
+// - palette: handle to the OpenGL texture containing the sprite sheet's
+//      palette if it's indexed, 0 otherwise.
 //////////////////////////////////////////////////////////////////////////
 
 typedef struct {
@@ -117,24 +129,13 @@ typedef struct {
     float max[2];
 } Sprites_CollisionBox;
 
-typedef enum {
-    SPRITES_ANIMATION_END_LOOP,
-    SPRITES_ANIMATION_END_KILL
-} Sprites_AnimationEndBehavior;
-
-typedef struct {
-    float frames[32][2];
-    int32_t numFrames;
-    Sprites_AnimationEndBehavior endBehavior;
-} Sprites_Animation;
-
 typedef struct {
     Sprites_CollisionBox collisionBox;
-    Sprites_Animation* animations;
+    Data_Animations animations;
     float sheetDims[2];
     float panelDims[2];
-    int32_t numAnimations;
     uint32_t texture;
+    uint32_t palette;
 } Sprites_Sprite;
 
 
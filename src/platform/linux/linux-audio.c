@@ -24,12 +24,17 @@
 #include <alloca.h>
 #include <alsa/asoundlib.h>
 #include <pthread.h>
+#include <string.h>
+#include <math.h>
+#include <stdatomic.h>
 #include "../../shared/constants.h"
 #include "../../shared/utils.h"
 #include "../../shared/debug.h"
 #include "../../shared/data.h"
 #include "../../shared/platform-interface.h"
+#include "../../shared/audio.h"
 #include "linux-audio.h"
+#include "linux-time.h"
 
 //////////////////////////////////////////////////////////////
 // Uses ALSA and pthread:
@@ -39,22 +44,85 @@
 
 #define MIX_BUFFER_FRAMES 2048
 
+///////////////////////////////////////////////////////////////////
+// Identical play requests from the same simulation tick would
+// start on the same sample, so if they're still waiting for the
+// mixer, they're merged into a single voice with a gain boost
+// instead of stacking up. Requests from different ticks stay
+// separate, even if the mixer picks them up together.
+///////////////////////////////////////////////////////////////////
+
+#define DEDUP_GAIN_STEP 0.25f
+#define DEDUP_MAX_GAIN 2.0f
+
+///////////////////////////////////////////////////////////////////
+// Voices are mixed into a float buffer and a look-ahead limiter
+// brings the sum back into 16-bit range. Gain reduction is
+// computed per block and ramped in over the block before the
+// peak, so output is delayed by one block.
+///////////////////////////////////////////////////////////////////
+
+#define LIMITER_BLOCK_FRAMES 64
+#define LIMITER_THRESHOLD (0.89f * INT16_MAX)
+#define LIMITER_RELEASE 0.01f // Max gain recovery per block
+
+#define PI_OVER_4 0.78539816f
+#define SQRT_2 1.41421356f
+
+///////////////////////////////////////////////////////////////////
+// ADPCM-compressed sounds are decoded one block at a time into
+// the channel's own scratch buffer as the cursor reaches them.
+// `count` and `cursor` are always in decoded samples.
+///////////////////////////////////////////////////////////////////
+
 typedef struct {
     int16_t* data;
+    uint8_t* blocks;
     int32_t count;
     int32_t cursor;
+    int32_t id;
+    int32_t priority;
+    int32_t age;
+    float gain;
+    float gainLeft;
+    float gainRight;
     bool loop;
+    int32_t decodedBlock;
+    int16_t decoded[AUDIO_ADPCM_BLOCK_SAMPLES];
 } AudioStream;
 
+typedef struct {
+    int32_t id;
+    int32_t triggers;
+    float attenuation;
+    float panSum;
+    bool loop;
+    uint32_t tick;
+} AudioRequest;
+
 static struct {
     Data_Buffer data[SPACE_SHOOTER_AUDIO_MAX_SOUNDS];
+    int32_t priority[SPACE_SHOOTER_AUDIO_MAX_SOUNDS];
+    int32_t maxInstances[SPACE_SHOOTER_AUDIO_MAX_SOUNDS];
+    int32_t samples[SPACE_SHOOTER_AUDIO_MAX_SOUNDS];
+    bool compressed[SPACE_SHOOTER_AUDIO_MAX_SOUNDS];
     int32_t count;
-} sounds;
+    pthread_mutex_t lock; // Sounds may be loaded from worker threads
+} sounds = {
+    .lock = PTHREAD_MUTEX_INITIALIZER
+};
+
+static struct {
+    snd_pcm_t* handle;
+    int32_t sampleRate;
+} device = {
+    .sampleRate = SPACE_SHOOTER_AUDIO_SAMPLE_RATE
+};
 
 static struct {
     pthread_t handle;
     struct {
-        AudioStream sounds[SPACE_SHOOTER_AUDIO_MIXER_CHANNELS];
+        AudioRequest requests[SPACE_SHOOTER_AUDIO_MIXER_CHANNELS];
         int32_t count;
         pthread_mutex_t lock;
     } queue;
@@ -65,114 +133,327 @@ static struct {
     bool initialized;
 } threadInterface;
 
-static void *audioThread(void* args) {
-    snd_pcm_t* device = NULL;
-    struct {
-        AudioStream channels[SPACE_SHOOTER_AUDIO_MIXER_CHANNELS];
-        int32_t count;
-        int16_t buffer[MIX_BUFFER_FRAMES * 2];
-    } mixer = { 0 };
+///////////////////////////////////////////////////////////////////
+// Written by the audio thread (and by platform_playSound for the
+// queue stats) and read by the game thread, so every field is
+// atomic. Relaxed ordering is enough since each field is an
+// independent counter or gauge.
+///////////////////////////////////////////////////////////////////
 
-    /////////////////////////////////////
-    // Open audio device and set to:
-    // - 16-bit
-    // - 44.1k
-    // - stereo
-    // - 2k sample (~50ms) buffer size
-    /////////////////////////////////////
+static struct {
+    atomic_uint xruns;
+    atomic_uint droppedRequests;
+    atomic_llong mixTime;
+    atomic_llong maxMixTime;
+    atomic_int activeVoices;
+    atomic_int queueHighWater;
+} mixerStats;
+
+typedef struct {
+    AudioStream channels[SPACE_SHOOTER_AUDIO_MIXER_CHANNELS];
+    int32_t count;
+    float buffer[(LIMITER_BLOCK_FRAMES + MIX_BUFFER_FRAMES) * 2];
+    int16_t output[MIX_BUFFER_FRAMES * 2];
+    float limiterGain;
+} Mixer;
+
+//////////////////////////////////////////////////////////////////
+// Find the channel a new sound should replace when the mixer is
+// full: lowest priority first, then the quietest, then the one
+// that has been playing longest. Returns -1 if every channel is
+// playing something more important.
+//////////////////////////////////////////////////////////////////
+
+static int32_t findVictimChannel(Mixer* mixer, int32_t priority) {
+    int32_t victim = -1;
+
+    for (int32_t i = 0; i < mixer->count; ++i) {
+        AudioStream* channel = mixer->channels + i;
+
+        if (channel->priority > priority) {
+            continue;
+        }
+
+        if (victim == -1) {
+            victim = i;
+            continue;
+        }
 
-    if (snd_pcm_open(&device, "default", SND_PCM_STREAM_PLAYBACK, 0) < 0) {
-        goto EXIT_NO_RESOURCES;
+        AudioStream* current = mixer->channels + victim;
+
+        if (channel->priority != current->priority) {
+            if (channel->priority < current->priority) {
+                victim = i;
+            }
+        } else if (channel->gain != current->gain) {
+            if (channel->gain < current->gain) {
+                victim = i;
+            }
+        } else if (channel->age > current->age) {
+            victim = i;
+        }
     }
 
-    snd_pcm_hw_params_t *deviceParams = NULL;
-    snd_pcm_hw_params_alloca(&deviceParams);
-    snd_pcm_hw_params_any(device, deviceParams);
+    return victim;
+}
 
-    if (snd_pcm_hw_params_set_access(device, deviceParams, SND_PCM_ACCESS_RW_INTERLEAVED) < 0) {
-        goto EXIT_DEVICE;   
+static void startSound(Mixer* mixer, AudioRequest* request) {
+    int32_t id = request->id;
+    float gain = 1.0f + DEDUP_GAIN_STEP * (request->triggers - 1);
+    if (gain > DEDUP_MAX_GAIN) {
+        gain = DEDUP_MAX_GAIN;
     }
+    gain *= 1.0f - request->attenuation;
+
+    // Constant-power pan, normalized so a centered sound has unit gain.
+    float panAngle = (request->panSum / request->triggers + 1.0f) * PI_OVER_4;
+
+    AudioStream* channel = NULL;
+
+    //////////////////////////////////////////////////
+    // If the sound is already playing as many times
+    // as allowed, restart its oldest instance.
+    //////////////////////////////////////////////////
 
-    if (snd_pcm_hw_params_set_format(device, deviceParams, SND_PCM_FORMAT_S16_LE) < 0) {
-        goto EXIT_DEVICE;   
+    if (sounds.maxInstances[id] > 0) {
+        int32_t instances = 0;
+        AudioStream* oldest = NULL;
+
+        for (int32_t i = 0; i < mixer->count; ++i) {
+            AudioStream* playing = mixer->channels + i;
+            if (playing->id == id) {
+                ++instances;
+                if (!oldest || playing->age > oldest->age) {
+                    oldest = playing;
+                }
+            }
+        }
+
+        if (instances >= sounds.maxInstances[id]) {
+            channel = oldest;
+        }
     }
 
-    if (snd_pcm_hw_params_set_rate(device, deviceParams, 44100, 0) < 0) {
-        goto EXIT_DEVICE;   
+    if (!channel) {
+        if (mixer->count < SPACE_SHOOTER_AUDIO_MIXER_CHANNELS) {
+            channel = mixer->channels + mixer->count;
+            ++mixer->count;
+        } else {
+            int32_t victim = findVictimChannel(mixer, sounds.priority[id]);
+
+            if (victim == -1) {
+                atomic_fetch_add_explicit(&mixerStats.droppedRequests, 1, memory_order_relaxed);
+                return;
+            }
+
+            channel = mixer->channels + victim;
+        }
     }
 
-    if (snd_pcm_hw_params_set_channels(device, deviceParams, 2) < 0) {
-        goto EXIT_DEVICE;   
+    if (sounds.compressed[id]) {
+        channel->data = NULL;
+        channel->blocks = sounds.data[id].data;
+    } else {
+        channel->data = (int16_t *) sounds.data[id].data;
+        channel->blocks = NULL;
     }
+    channel->decodedBlock = -1;
+    channel->count = sounds.samples[id];
+    channel->cursor = 0;
+    channel->id = id;
+    channel->priority = sounds.priority[id];
+    channel->age = 0;
+    channel->gain = gain;
+    channel->gainLeft = gain * cosf(panAngle) * SQRT_2;
+    channel->gainRight = gain * sinf(panAngle) * SQRT_2;
+    channel->loop = request->loop;
+}
+
+//////////////////////////////////////////////////////////////////
+// Add a channel into the mix buffer. The channel is processed in
+// contiguous spans between loop points so the inner loop has no
+// branches and can be vectorized.
+//////////////////////////////////////////////////////////////////
+
+static void mixChannel(AudioStream* channel, float* buffer, int32_t numSamples) {
+    DEBUG_ASSERT(channel->count > 0, "linux-audio.c: Mixer should not be playing empty sounds.");
+
+    float gainLeft = channel->gainLeft;
+    float gainRight = channel->gainRight;
+    int32_t mixed = 0;
+
+    while (mixed < numSamples) {
+        if (channel->cursor == channel->count) {
+            if (channel->loop) {
+                channel->cursor = 0;
+            } else {
+                break;
+            }
+        }
+
+        int32_t span = channel->count - channel->cursor;
+        if (span > numSamples - mixed) {
+            span = numSamples - mixed;
+        }
+
+        int16_t* in = NULL;
+        if (channel->blocks) {
+            int32_t block = channel->cursor / AUDIO_ADPCM_BLOCK_SAMPLES;
+            int32_t blockCursor = channel->cursor % AUDIO_ADPCM_BLOCK_SAMPLES;
+
+            if (block != channel->decodedBlock) {
+                audio_decodeAdpcmBlock(channel->blocks + block * AUDIO_ADPCM_BLOCK_BYTES, channel->decoded);
+                channel->decodedBlock = block;
+            }
+
+            if (span > AUDIO_ADPCM_BLOCK_SAMPLES - blockCursor) {
+                span = AUDIO_ADPCM_BLOCK_SAMPLES - blockCursor;
+            }
+
+            in = channel->decoded + blockCursor;
+        } else {
+            in = channel->data + channel->cursor;
+        }
+
+        float* out = buffer + mixed;
+
+        for (int32_t i = 0; i < span; i += 2) {
+            out[i]     += in[i] * gainLeft;
+            out[i + 1] += in[i + 1] * gainRight;
+        }
 
-    if (snd_pcm_hw_params_set_buffer_size(device, deviceParams, MIX_BUFFER_FRAMES) < 0) {
-        goto EXIT_DEVICE;   
+        mixed += span;
+        channel->cursor += span;
     }
 
-    if (snd_pcm_hw_params(device, deviceParams) < 0) {
-        goto EXIT_DEVICE;   
+    channel->age += numSamples;
+}
+
+// Gain needed to keep the block below the limiter threshold.
+static float limiterTarget(float* samples, int32_t count) {
+    float peaks[8] = { 0 };
+
+    for (int32_t i = 0; i < count; i += 8) {
+        for (int32_t j = 0; j < 8; ++j) {
+            float sample = fabsf(samples[i + j]);
+            peaks[j] = sample > peaks[j] ? sample : peaks[j];
+        }
     }
 
+    float peak = 0.0f;
+    for (int32_t j = 0; j < 8; ++j) {
+        peak = peaks[j] > peak ? peaks[j] : peak;
+    }
+
+    return peak > LIMITER_THRESHOLD ? LIMITER_THRESHOLD / peak : 1.0f;
+}
+
+//////////////////////////////////////////////////////////////////
+// Convert the mix buffer to 16-bit output. Each block's gain is
+// ramped from its starting value to a value no higher than its
+// own target or the next block's, so gain reduction is already
+// in place when a peak arrives. The last block of the buffer
+// is only used as look-ahead and is carried into the next
+// period.
+//////////////////////////////////////////////////////////////////
+
+static void applyLimiter(Mixer* mixer) {
+    int32_t blockSamples = LIMITER_BLOCK_FRAMES * 2;
+    int32_t numBlocks = MIX_BUFFER_FRAMES / LIMITER_BLOCK_FRAMES;
+    float target = limiterTarget(mixer->buffer, blockSamples);
+
+    for (int32_t b = 0; b < numBlocks; ++b) {
+        float* in = mixer->buffer + b * blockSamples;
+        int16_t* out = mixer->output + b * blockSamples;
+        float nextTarget = limiterTarget(in + blockSamples, blockSamples);
+
+        float startGain = mixer->limiterGain;
+        float endGain = startGain + LIMITER_RELEASE;
+        if (endGain > target) {
+            endGain = target;
+        }
+        if (endGain > nextTarget) {
+            endGain = nextTarget;
+        }
+        float gainStep = (endGain - startGain) / LIMITER_BLOCK_FRAMES;
+
+        for (int32_t i = 0; i < LIMITER_BLOCK_FRAMES; ++i) {
+            float gain = startGain + gainStep * (i + 1);
+            float left = in[i * 2] * gain;
+            float right = in[i * 2 + 1] * gain;
+
+            // Only reachable through rounding error.
+            left = left > INT16_MAX ? INT16_MAX : left;
+            left = left < INT16_MIN ? INT16_MIN : left;
+            right = right > INT16_MAX ? INT16_MAX : right;
+            right = right < INT16_MIN ? INT16_MIN : right;
+
+            out[i * 2] = (int16_t) left;
+            out[i * 2 + 1] = (int16_t) right;
+        }
+
+        mixer->limiterGain = endGain;
+        target = nextTarget;
+    }
+
+    int32_t outputSamples = MIX_BUFFER_FRAMES * 2;
+    memcpy(mixer->buffer, mixer->buffer + outputSamples, blockSamples * sizeof(float));
+    memset(mixer->buffer + blockSamples, 0, outputSamples * sizeof(float));
+}
+
+static void *audioThread(void* args) {
+    static Mixer mixer = { .limiterGain = 1.0f };
+    AudioRequest requests[SPACE_SHOOTER_AUDIO_MIXER_CHANNELS];
+
     bool running = true;
     while (running) {  
  
         //////////////////////////////////////
-        // Copy queued audio into mixer
+        // Copy queued requests out so the
+        // lock isn't held while mixing.
         //////////////////////////////////////
 
         pthread_mutex_lock(&threadInterface.queue.lock);
 
-        if (threadInterface.queue.count > 0) {
-            int32_t channelsAvailable = SPACE_SHOOTER_AUDIO_MIXER_CHANNELS - mixer.count;
-            int32_t copyCount = channelsAvailable < threadInterface.queue.count ? channelsAvailable : threadInterface.queue.count;
-            for (int32_t i = 0; i < copyCount; ++i) {
-                mixer.channels[mixer.count] = threadInterface.queue.sounds[i];
-                ++mixer.count;
-            }
-            threadInterface.queue.count = 0;  
+        int32_t requestCount = threadInterface.queue.count;
+        for (int32_t i = 0; i < requestCount; ++i) {
+            requests[i] = threadInterface.queue.requests[i];
         }
+        threadInterface.queue.count = 0;
 
         pthread_mutex_unlock(&threadInterface.queue.lock);
 
-        //////////////////////////////////////
-        // Simple additive mix with clipping
-        //////////////////////////////////////
-
-        int32_t numSamples = MIX_BUFFER_FRAMES * 2;
-
-        for (int32_t i = 0; i < numSamples; ++i) {
-            mixer.buffer[i] = 0;
-        }  
-
-        for (int32_t i = 0; i < mixer.count; ++i) {
-            AudioStream* channel = mixer.channels + i;
+        int64_t mixStartTime = linux_currentTime();
 
-            DEBUG_ASSERT(channel->count > 0, "linux-audio.c: Mixer should not be playing empty sounds.")
+        //////////////////////////////////////////////
+        // Start sounds in priority order so that
+        // important sounds get voices first.
+        //////////////////////////////////////////////
 
-            for (int32_t i = 0; i < numSamples; ++i) {
-                if (channel->cursor == channel->count) {
-                    if (channel->loop) {
-                        channel->cursor = 0;
-                    } else {
-                        break;
-                    }
-                }
+        for (int32_t i = 1; i < requestCount; ++i) {
+            AudioRequest request = requests[i];
+            int32_t j = i - 1;
+            while (j >= 0 && sounds.priority[requests[j].id] < sounds.priority[request.id]) {
+                requests[j + 1] = requests[j];
+                --j;
+            }
+            requests[j + 1] = request;
+        }
 
-                int32_t sample = mixer.buffer[i] + channel->data[channel->cursor];
-                
-                if (sample < INT16_MIN) {
-                    sample = INT16_MIN;
-                }
+        for (int32_t i = 0; i < requestCount; ++i) {
+            startSound(&mixer, requests + i);
+        }
 
-                if (sample > INT16_MAX) {
-                    sample = INT16_MAX;
-                }
+        ////////////////////////////////////////////
+        // Additive mix followed by a soft limiter
+        ////////////////////////////////////////////
 
-                mixer.buffer[i] = sample;
-                ++channel->cursor;
-            }
+        for (int32_t i = 0; i < mixer.count; ++i) {
+            mixChannel(mixer.channels + i, mixer.buffer + LIMITER_BLOCK_FRAMES * 2, MIX_BUFFER_FRAMES * 2);
         }
 
+        applyLimiter(&mixer);
+
         //////////////////////////////////////
         // Handle streams that have finished.
         //////////////////////////////////////
@@ -185,18 +466,23 @@ static void *audioThread(void* args) {
                 //////////////////////////////////////////////////////////////
 
                 int32_t last = mixer.count - 1;
-                mixer.channels[i].data = mixer.channels[last].data;
-                mixer.channels[i].count = mixer.channels[last].count;
-                mixer.channels[i].cursor = mixer.channels[last].cursor;
-                mixer.channels[i].loop = mixer.channels[last].loop;
+                mixer.channels[i] = mixer.channels[last];
 
                 --mixer.count;
             }
         }
+
+        int64_t mixTime = linux_currentTime() - mixStartTime;
+        atomic_store_explicit(&mixerStats.mixTime, mixTime, memory_order_relaxed);
+        if (mixTime > atomic_load_explicit(&mixerStats.maxMixTime, memory_order_relaxed)) {
+            atomic_store_explicit(&mixerStats.maxMixTime, mixTime, memory_order_relaxed);
+        }
+        atomic_store_explicit(&mixerStats.activeVoices, mixer.count, memory_order_relaxed);
         
         // This blocks until the device needs more data
-        if (snd_pcm_writei(device, mixer.buffer, MIX_BUFFER_FRAMES) < 0) {
-            snd_pcm_prepare(device);
+        if (snd_pcm_writei(device.handle, mixer.output, MIX_BUFFER_FRAMES) < 0) {
+            atomic_fetch_add_explicit(&mixerStats.xruns, 1, memory_order_relaxed);
+            snd_pcm_prepare(device.handle);
         }
 
         pthread_mutex_lock(&threadInterface.shutdown.lock);
@@ -206,22 +492,65 @@ static void *audioThread(void* args) {
         pthread_mutex_unlock(&threadInterface.shutdown.lock);
     }
 
-    EXIT_DEVICE:
-    snd_pcm_drop(device);
-    snd_pcm_close(device);
-
-    EXIT_NO_RESOURCES:
     return NULL;
 }
 
 bool linux_initAudio(void) {
 
+    //////////////////////////////////////////////////////
+    // Open audio device and set to:
+    // - 16-bit
+    // - the device's native rate (sounds are converted
+    //   to it when they're loaded, so ALSA's plug layer
+    //   doesn't have to resample while playing)
+    // - stereo
+    // - 2k sample (~50ms) buffer size
+    //////////////////////////////////////////////////////
+
+    if (snd_pcm_open(&device.handle, "default", SND_PCM_STREAM_PLAYBACK, 0) < 0) {
+        goto ERROR_NO_RESOURCES;
+    }
+
+    snd_pcm_hw_params_t *deviceParams = NULL;
+    snd_pcm_hw_params_alloca(&deviceParams);
+    snd_pcm_hw_params_any(device.handle, deviceParams);
+
+    if (snd_pcm_hw_params_set_access(device.handle, deviceParams, SND_PCM_ACCESS_RW_INTERLEAVED) < 0) {
+        goto ERROR_DEVICE;   
+    }
+
+    if (snd_pcm_hw_params_set_format(device.handle, deviceParams, SND_PCM_FORMAT_S16_LE) < 0) {
+        goto ERROR_DEVICE;   
+    }
+
+    if (snd_pcm_hw_params_set_channels(device.handle, deviceParams, 2) < 0) {
+        goto ERROR_DEVICE;   
+    }
+
+    // Restrict the configuration space to rates the hardware supports directly.
+    snd_pcm_hw_params_set_rate_resample(device.handle, deviceParams, 0);
+
+    unsigned int rate = SPACE_SHOOTER_AUDIO_SAMPLE_RATE;
+    if (snd_pcm_hw_params_set_rate_near(device.handle, deviceParams, &rate, 0) < 0) {
+        goto ERROR_DEVICE;   
+    }
+
+    if (snd_pcm_hw_params_set_buffer_size(device.handle, deviceParams, MIX_BUFFER_FRAMES) < 0) {
+        goto ERROR_DEVICE;   
+    }
+
+    if (snd_pcm_hw_params(device.handle, deviceParams) < 0) {
+        goto ERROR_DEVICE;   
+    }
+
+    device.sampleRate = rate;
+
     ////////////////////////
     // Create audio thread
     ////////////////////////
 
     if (pthread_mutex_init(&threadInterface.queue.lock, NULL)) {
-        goto ERROR_NO_RESOURCES;
+        goto ERROR_DEVICE;
     }
 
     if (pthread_mutex_init(&threadInterface.shutdown.lock, NULL)) {
@@ -250,52 +579,141 @@ bool linux_initAudio(void) {
     ERROR_QUEUE_LOCK:
     pthread_mutex_destroy(&threadInterface.queue.lock);
 
+    ERROR_DEVICE:
+    snd_pcm_close(device.handle);
+    device.handle = NULL;
+    device.sampleRate = SPACE_SHOOTER_AUDIO_SAMPLE_RATE;
+
     ERROR_NO_RESOURCES:
     return false;
 }
 
-int32_t platform_loadSound(const char* fileName) {
-    DEBUG_ASSERT(sounds.count < SPACE_SHOOTER_AUDIO_MAX_SOUNDS, "Attempting to load too many sounds.");
+int32_t platform_loadSound(const char* fileName, Game_SoundOptions* opts) {
+    Game_SoundOptions defaultOpts = { 0 };
+    if (!opts) {
+        opts = &defaultOpts;
+    }
 
-    int32_t id = sounds.count;
+    Data_Buffer pcm = { 0 };
     
-    if (!utils_loadWavData(fileName, sounds.data + id)) {
+    if (!utils_loadWavData(fileName, &pcm, device.sampleRate)) {
         return -1;
     }
 
+    int32_t samples = (pcm.size / 4) * 2; // Whole frames only
+    Data_Buffer data = pcm;
+
+    if (opts->compress) {
+        bool encoded = audio_encodeAdpcm(&pcm, &data);
+        data_freeBuffer(&pcm);
+
+        if (!encoded) {
+            return -1;
+        }
+    }
+
+    //////////////////////////////////////////////
+    // Decoding is done outside the lock so sounds
+    // can load in parallel. Only registering the
+    // sound is serialized.
+    //////////////////////////////////////////////
+
+    pthread_mutex_lock(&sounds.lock);
+
+    DEBUG_ASSERT(sounds.count < SPACE_SHOOTER_AUDIO_MAX_SOUNDS, "Attempting to load too many sounds.");
+
+    int32_t id = sounds.count;
+    sounds.data[id] = data;
+    sounds.samples[id] = samples;
+    sounds.compressed[id] = opts->compress;
+    sounds.priority[id] = opts->priority;
+    sounds.maxInstances[id] = opts->maxInstances;
     ++sounds.count;
 
+    pthread_mutex_unlock(&sounds.lock);
+
     return id;
 }
 
-void platform_playSound(int32_t id, bool loop) {
-    if (!threadInterface.initialized) {
+void platform_playSound(int32_t id, Game_PlaySoundOptions* opts) {
+    if (!threadInterface.initialized || id < 0) {
         return;
     }
 
+    DEBUG_ASSERT(id < sounds.count, "Invalid sound ID.");
+
     if (!sounds.data[id].data) {
         return;
     }
 
-    ////////////////////////
-    // Add sound to queue
-    ////////////////////////
+    Game_PlaySoundOptions defaultOpts = { 0 };
+    if (!opts) {
+        opts = &defaultOpts;
+    }
+
+    ////////////////////////////////////////////
+    // Add sound to queue, merging it with an
+    // identical request from the same tick if
+    // one is waiting.
+    ////////////////////////////////////////////
 
     pthread_mutex_lock(&threadInterface.queue.lock);
 
-    if (threadInterface.queue.count < SPACE_SHOOTER_AUDIO_MIXER_CHANNELS) {
-        int32_t soundIndex = threadInterface.queue.count;
-        threadInterface.queue.sounds[soundIndex].data = (int16_t *) sounds.data[id].data;
-        threadInterface.queue.sounds[soundIndex].count = sounds.data[id].size / 2;
-        threadInterface.queue.sounds[soundIndex].cursor = 0;
-        threadInterface.queue.sounds[soundIndex].loop = loop;
+    bool merged = false;
+    for (int32_t i = 0; i < threadInterface.queue.count; ++i) {
+        AudioRequest* request = threadInterface.queue.requests + i;
+        if (request->id == id && request->loop == opts->loop && request->tick == opts->tick) {
+            ++request->triggers;
+            request->panSum += opts->pan;
+            if (opts->attenuation < request->attenuation) {
+                request->attenuation = opts->attenuation;
+            }
+            merged = true;
+            break;
+        }
+    }
 
-        ++threadInterface.queue.count;
+    if (!merged) {
+        if (threadInterface.queue.count < SPACE_SHOOTER_AUDIO_MIXER_CHANNELS) {
+            AudioRequest* request = threadInterface.queue.requests + threadInterface.queue.count;
+            request->id = id;
+            request->triggers = 1;
+            request->attenuation = opts->attenuation;
+            request->panSum = opts->pan;
+            request->loop = opts->loop;
+            request->tick = opts->tick;
+
+            ++threadInterface.queue.count;
+
+            // Only written here, under the queue lock.
+            if (threadInterface.queue.count > atomic_load_explicit(&mixerStats.queueHighWater, memory_order_relaxed)) {
+                atomic_store_explicit(&mixerStats.queueHighWater, threadInterface.queue.count, memory_order_relaxed);
+            }
+        } else {
+            atomic_fetch_add_explicit(&mixerStats.droppedRequests, 1, memory_order_relaxed);
+        }
     }
 
     pthread_mutex_unlock(&threadInterface.queue.lock); 
 }
 
+bool platform_getAudioStats(Game_AudioStats* stats) {
+    if (!threadInterface.initialized) {
+        *stats = (Game_AudioStats) { 0 };
+        return false;
+    }
+
+    stats->xruns = atomic_load_explicit(&mixerStats.xruns, memory_order_relaxed);
+    stats->droppedRequests = atomic_load_explicit(&mixerStats.droppedRequests, memory_order_relaxed);
+    stats->mixTime = atomic_load_explicit(&mixerStats.mixTime, memory_order_relaxed);
+    stats->maxMixTime = atomic_load_explicit(&mixerStats.maxMixTime, memory_order_relaxed);
+    stats->periodTime = MIX_BUFFER_FRAMES * SPACE_SHOOTER_SECOND / device.sampleRate;
+    stats->activeVoices = atomic_load_explicit(&mixerStats.activeVoices, memory_order_relaxed);
+    stats->queueHighWater = atomic_load_explicit(&mixerStats.queueHighWater, memory_order_relaxed);
+
+    return true;
+}
+
 void linux_closeAudio(void) {
     if (!threadInterface.initialized) {
         return;
@@ -308,6 +726,10 @@ void linux_closeAudio(void) {
     pthread_join(threadInterface.handle, NULL);
     pthread_mutex_destroy(&threadInterface.queue.lock);
     pthread_mutex_destroy(&threadInterface.shutdown.lock);
+
+    snd_pcm_drop(device.handle);
+    snd_pcm_close(device.handle);
+    device.handle = NULL;
     
     threadInterface.initialized = false;
 }
@@ -0,0 +1,140 @@
+////////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+// 
+// Copyright (c) 2021 Tarek Sherif
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////////
+
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include "../../shared/constants.h"
+#include "../../shared/debug.h"
+#include "linux-events.h"
+#include "linux-time.h"
+
+#define MIN_WAIT_TIME (SPACE_SHOOTER_MILLISECOND / 2)
+#define MAX_EVENTS 4
+
+// Tags for the epoll data, to tell what woke the wait up.
+enum {
+    EVENT_SOURCE_TIMER,
+    EVENT_SOURCE_INPUT
+};
+
+static struct {
+    int32_t epollFd;
+    int32_t timerFd;
+} events = {
+    .epollFd = -1,
+    .timerFd = -1
+};
+
+static bool addFd(int32_t fd, int32_t source) {
+    struct epoll_event event = {
+        .events = EPOLLIN,
+        .data = { .u32 = source }
+    };
+
+    return epoll_ctl(events.epollFd, EPOLL_CTL_ADD, fd, &event) == 0;
+}
+
+bool linux_initEvents(Display* display) {
+    events.epollFd = epoll_create1(EPOLL_CLOEXEC);
+
+    if (events.epollFd == -1) {
+        DEBUG_LOG("linux_initEvents: Failed to create epoll instance.");
+        goto ERROR_NO_RESOURCES;
+    }
+
+    events.timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+
+    if (events.timerFd == -1) {
+        DEBUG_LOG("linux_initEvents: Failed to create timer.");
+        goto ERROR_EPOLL;
+    }
+
+    if (!addFd(events.timerFd, EVENT_SOURCE_TIMER) || !addFd(ConnectionNumber(display), EVENT_SOURCE_INPUT)) {
+        DEBUG_LOG("linux_initEvents: Failed to add fds to epoll instance.");
+        goto ERROR_TIMER;
+    }
+
+    return true;
+
+    ERROR_TIMER:
+    close(events.timerFd);
+    events.timerFd = -1;
+
+    ERROR_EPOLL:
+    close(events.epollFd);
+    events.epollFd = -1;
+
+    ERROR_NO_RESOURCES:
+    return false;
+}
+
+bool linux_waitForEvents(int64_t deadline) {
+    if (deadline - linux_currentTime() <= MIN_WAIT_TIME) {
+        return false;
+    }
+
+    struct timespec deadlineSpec = {
+        .tv_sec = deadline / SPACE_SHOOTER_SECOND,
+        .tv_nsec = deadline % SPACE_SHOOTER_SECOND
+    };
+
+    if (events.epollFd == -1) {
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadlineSpec, NULL) == EINTR);
+        return false;
+    }
+
+    timerfd_settime(events.timerFd, TFD_TIMER_ABSTIME, &(struct itimerspec) { .it_value = deadlineSpec }, NULL);
+
+    struct epoll_event ready[MAX_EVENTS];
+    int32_t numReady = 0;
+
+    while ((numReady = epoll_wait(events.epollFd, ready, MAX_EVENTS, -1)) == -1 && errno == EINTR);
+
+    bool input = false;
+
+    for (int32_t i = 0; i < numReady; ++i) {
+        if (ready[i].data.u32 == EVENT_SOURCE_TIMER) {
+            uint64_t expirations;
+            while (read(events.timerFd, &expirations, sizeof(expirations)) == -1 && errno == EINTR);
+        } else {
+            input = true;
+        }
+    }
+
+    return input;
+}
+
+void linux_closeEvents(void) {
+    if (events.timerFd != -1) {
+        close(events.timerFd);
+        events.timerFd = -1;
+    }
+
+    if (events.epollFd != -1) {
+        close(events.epollFd);
+        events.epollFd = -1;
+    }
+}
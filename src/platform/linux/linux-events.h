@@ -0,0 +1,55 @@
+////////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+// 
+// Copyright (c) 2021 Tarek Sherif
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _LINUX_EVENTS_H_
+#define _LINUX_EVENTS_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <X11/Xlib.h>
+
+//////////////////////////////////////////////////////////////////
+// Blocking wait for input on Linux. The main loop sleeps in
+// epoll on the X connection and a timerfd set to the frame
+// deadline, so it only wakes up when there's input to handle or
+// a frame to draw. Gamepad input is read on its own thread (see
+// linux-gamepad.h).
+//
+// - linux_initEvents(): Set up waiting on `display`'s
+//      connection. Returns false if epoll or the timer isn't
+//      available, in which case linux_waitForEvents() just
+//      sleeps until the deadline.
+// - linux_waitForEvents(): Wait until input arrives or the
+//      deadline (ns, CLOCK_MONOTONIC) passes. Returns true if
+//      there's input to handle, or false once the deadline has
+//      passed. Xlib may already have read events off the
+//      connection, so they should be drained with XPending()
+//      before each call.
+// - linux_closeEvents(): Release the epoll and timer fds.
+//////////////////////////////////////////////////////////////////
+
+bool linux_initEvents(Display* display);
+bool linux_waitForEvents(int64_t deadline);
+void linux_closeEvents(void);
+
+#endif
@@ -37,21 +37,108 @@
 #include <unistd.h>
 #include <dirent.h>
 #include <math.h>
+#include <time.h>
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
 #include "linux-gamepad.h"
+#include "linux-time.h"
 #include "../../shared/constants.h"
 #include "../../shared/debug.h"
 
 #define PATH_MAX 512
+#define DEVICE_DIR "/dev/input"
 #define INPUT_DIR "/dev/input/by-id"
+#define INPUT_DIR_NAME "by-id"
+#define HOTPLUG_BUFFER_SIZE 4096
+#define MAX_EVENTS 4
+
+//////////////////////////////////////////////////////////////
+// Gamepad input is handled by its own thread, which blocks
+// in epoll on the gamepad, on inotify for input devices
+// being connected, and on an eventfd used to stop it. Each
+// batch of events read from the gamepad is reduced to a
+// single state, which is published to the main thread
+// through a seqlock, so the main thread makes no syscalls
+// to get gamepad input.
+//////////////////////////////////////////////////////////////
+
+// Tags for the epoll data, to tell what woke the thread up.
+enum {
+    EVENT_SOURCE_WAKE,
+    EVENT_SOURCE_HOTPLUG,
+    EVENT_SOURCE_GAMEPAD
+};
 
+// Press counts are only ever incremented, so the main
+// thread can tell Start or Back was pressed since it last
+// looked, even if it's been released again since.
+// Presses and releases of A go in a ring of timestamped
+// events instead, for the game's input queue, with a count
+// of all events ever added so the main thread can tell
+// which ones it hasn't seen.
+typedef struct {
+    float stickX;
+    float stickY;
+    bool aButton;
+    bool startButton;
+    bool backButton;
+    bool connected;
+    uint32_t startPresses;
+    uint32_t backPresses;
+    Game_InputEvent aEvents[GAME_INPUT_MAX_EVENTS];
+    uint32_t aEventCount;
+    int64_t time;
+} GamepadState;
+
+// Only used by the input thread once it's started.
 static struct {
+    pthread_t thread;
+    bool started;
+    int32_t epollFd;
+    int32_t wakeFd;
+    int32_t inotifyFd;
+    int32_t inputDirWatch;
     int32_t fd;
+    bool monotonicTimestamps;
     int16_t stickX;
     int16_t stickY;
+    GamepadState state;
 } gamepadData = {
+    .epollFd = -1,
+    .wakeFd = -1,
+    .inotifyFd = -1,
+    .inputDirWatch = -1,
     .fd = -1
 };
 
+//////////////////////////////////////////////////////////////
+// The sequence is odd while the input thread is writing the
+// state, and the main thread retries its copy if the
+// sequence was odd or changed while it was copying. The
+// main thread stores the last sequence it applied in
+// `consumed`, which tells the input thread whether the
+// input time it published has been seen yet.
+//////////////////////////////////////////////////////////////
+
+static struct {
+    atomic_uint sequence;
+    atomic_uint consumed;
+    GamepadState state;
+} published;
+
+// Only used by the main thread.
+static struct {
+    uint32_t sequence;
+    uint32_t aEventCount;
+    uint32_t startPresses;
+    uint32_t backPresses;
+    bool latched;
+} reader;
+
 // Test single bit in multi-byte array
 static bool testBit(uint8_t* bitField, int32_t bit) {
     int32_t byte = bit / 8;
@@ -94,11 +181,54 @@ static bool endsWith(const char* s, const char* suffix) {
     return true;
 }
 
-void linux_detectGamepad(void) {
-    if (gamepadData.fd != -1) {
-        return;
+static bool addFd(int32_t fd, int32_t source) {
+    struct epoll_event event = {
+        .events = EPOLLIN,
+        .data = { .u32 = source }
+    };
+
+    return epoll_ctl(gamepadData.epollFd, EPOLL_CTL_ADD, fd, &event) == 0;
+}
+
+static int64_t eventTime(struct input_event* event) {
+    if (gamepadData.monotonicTimestamps) {
+        return event->input_event_sec * SPACE_SHOOTER_SECOND + event->input_event_usec * 1000ll;
     }
-    
+
+    return linux_currentTime();
+}
+
+static void publishState(int64_t changeTime) {
+    uint32_t sequence = atomic_load_explicit(&published.sequence, memory_order_relaxed);
+
+    // Keep the oldest change the main thread hasn't seen.
+    if (atomic_load_explicit(&published.consumed, memory_order_acquire) == sequence || !gamepadData.state.time) {
+        gamepadData.state.time = changeTime;
+    }
+
+    atomic_store_explicit(&published.sequence, sequence + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    published.state = gamepadData.state;
+    atomic_store_explicit(&published.sequence, sequence + 2, memory_order_release);
+}
+
+static uint32_t readState(GamepadState* state) {
+    uint32_t sequence = 0;
+
+    do {
+        sequence = atomic_load_explicit(&published.sequence, memory_order_acquire);
+        *state = published.state;
+        atomic_thread_fence(memory_order_acquire);
+    } while ((sequence & 1) || sequence != atomic_load_explicit(&published.sequence, memory_order_relaxed));
+
+    return sequence;
+}
+
+// Opening and querying devices can block for a while on
+// slow udev setups, which only holds up the input thread.
+static void connectGamepad(void) {
+    int32_t fd = -1;
+
     DIR* inputDir = opendir(INPUT_DIR);
 
     if (!inputDir) {
@@ -115,15 +245,15 @@ void linux_detectGamepad(void) {
         if (endsWith(entry->d_name, "-event-joystick")) {
             char path[PATH_MAX];
             snprintf(path, PATH_MAX, "%s/%s", INPUT_DIR, entry->d_name);
-            gamepadData.fd = open(path, O_RDONLY | O_NONBLOCK);
+            fd = open(path, O_RDONLY | O_NONBLOCK);
 
-            if (gamepadData.fd == -1) {
+            if (fd == -1) {
                 goto ERROR_NEXT;
             }
 
             // Get bitfields to test for gamepad capabilities
             uint8_t evBits[(EV_CNT + 7) / 8] = { 0 };
-            if (ioctl(gamepadData.fd, EVIOCGBIT(0, sizeof(evBits)), evBits) < 0) {
+            if (ioctl(fd, EVIOCGBIT(0, sizeof(evBits)), evBits) < 0) {
                 goto ERROR_FILE_OPENED;
             }
 
@@ -132,7 +262,7 @@ void linux_detectGamepad(void) {
             }
 
             uint8_t absBits[(ABS_CNT + 7) / 8] = { 0 };
-            if (ioctl(gamepadData.fd, EVIOCGBIT(EV_ABS, sizeof(absBits)), absBits) < 0) {
+            if (ioctl(fd, EVIOCGBIT(EV_ABS, sizeof(absBits)), absBits) < 0) {
                 goto ERROR_FILE_OPENED;
             }
 
@@ -142,7 +272,7 @@ void linux_detectGamepad(void) {
             }
 
             uint8_t keyBits[(KEY_CNT + 7) / 8] = { 0 };
-            if (ioctl(gamepadData.fd, EVIOCGBIT(EV_KEY, sizeof(keyBits)), keyBits) < 0) {
+            if (ioctl(fd, EVIOCGBIT(EV_KEY, sizeof(keyBits)), keyBits) < 0) {
                 goto ERROR_FILE_OPENED;
             }
 
@@ -151,12 +281,24 @@ void linux_detectGamepad(void) {
                 goto ERROR_FILE_OPENED;
             }
 
+            if (!addFd(fd, EVENT_SOURCE_GAMEPAD)) {
+                goto ERROR_FILE_OPENED;
+            }
+
+            // Event timestamps default to CLOCK_REALTIME. If they
+            // can't be switched, events are stamped when they're read.
+            int32_t clock = CLOCK_MONOTONIC;
+            gamepadData.monotonicTimestamps = ioctl(fd, EVIOCSCLOCKID, &clock) == 0;
+
             // Success!
+            gamepadData.fd = fd;
+            gamepadData.state.connected = true;
+            publishState(0);
             break;
 
             ERROR_FILE_OPENED:
-            close(gamepadData.fd);
-            gamepadData.fd = -1;
+            close(fd);
+            fd = -1;
         }
 
         ERROR_NEXT:
@@ -166,63 +308,346 @@ void linux_detectGamepad(void) {
     closedir(inputDir);
 }
 
-void linux_updateGamepad(Linux_Gamepad* gamepad) {
-    if (gamepadData.fd == -1) {
-        gamepad->keyboard = true;
+// Closing the fd also removes it from the epoll set.
+// Released buttons aren't published, so the main thread
+// keeps the last state until the keyboard changes it.
+static void disconnectGamepad(void) {
+    close(gamepadData.fd);
+    gamepadData.fd = -1;
+    gamepadData.state.connected = false;
+    publishState(0);
+}
+
+// INPUT_DIR only exists once an input device with an id
+// has been connected, so it's watched for in DEVICE_DIR
+// if it isn't there yet.
+static void watchInputDir(void) {
+    gamepadData.inputDirWatch = inotify_add_watch(gamepadData.inotifyFd, INPUT_DIR, IN_CREATE | IN_MOVED_TO);
+}
+
+// Returns whether input devices changed.
+static bool readHotplug(void) {
+    uint8_t buffer[HOTPLUG_BUFFER_SIZE] __attribute__ ((aligned(__alignof__(struct inotify_event))));
+    bool changed = false;
+    ssize_t bytesRead = 0;
+
+    while ((bytesRead = read(gamepadData.inotifyFd, buffer, sizeof(buffer))) > 0) {
+        for (uint8_t* offset = buffer; offset < buffer + bytesRead;) {
+            struct inotify_event* event = (struct inotify_event *) offset;
+
+            ///////////////////////////////////////////////////////
+            // udev removes INPUT_DIR along with its last link,
+            // which also removes the watch, so it's watched for
+            // again. When it's recreated, the gamepad's link may
+            // already be in it before the watch is added, so it's
+            // opened right away rather than waiting for an event.
+            ///////////////////////////////////////////////////////
+
+            if (event->wd == gamepadData.inputDirWatch && (event->mask & IN_IGNORED)) {
+                gamepadData.inputDirWatch = -1;
+            } else if (gamepadData.inputDirWatch == -1 && (event->mask & IN_ISDIR) && event->len > 0 && strcmp(event->name, INPUT_DIR_NAME) == 0) {
+                watchInputDir();
+
+                if (gamepadData.fd == -1) {
+                    connectGamepad();
+                }
+            }
+
+            changed = true;
+            offset += sizeof(struct inotify_event) + event->len;
+        }
+    }
+
+    return changed;
+}
+
+static void updateStick(void) {
+    float x = gamepadData.stickX;
+    float y = gamepadData.stickY;
+
+    float mag = (float) sqrt(x * x + y * y);
+    x /= mag;
+    y /= mag;
+
+    if (mag > SPACE_SHOOTER_GAMEPAD_STICK_DEADZONE) {
+        mag -= SPACE_SHOOTER_GAMEPAD_STICK_DEADZONE;
+        mag /= 32767.0f - SPACE_SHOOTER_GAMEPAD_STICK_DEADZONE;
+        gamepadData.state.stickX = x * mag;
+        gamepadData.state.stickY = -y * mag;
+    } else {
+        gamepadData.state.stickX = 0.0f;
+        gamepadData.state.stickY = 0.0f;
+    }
+}
+
+static void updateAButton(bool pressed, int64_t time) {
+    GamepadState* state = &gamepadData.state;
+
+    if (pressed == state->aButton) {
         return;
     }
 
+    state->aEvents[state->aEventCount % GAME_INPUT_MAX_EVENTS] = (Game_InputEvent) {
+        .time = time,
+        .shoot = pressed
+    };
+    ++state->aEventCount;
+    state->aButton = pressed;
+}
+
+static void updateButton(bool* button, uint32_t* presses, bool pressed) {
+    if (pressed && !*button) {
+        ++*presses;
+    }
+
+    *button = pressed;
+}
+
+// Reads everything that's queued and publishes once, so the
+// stick deadzone is only computed once for however many
+// axis events came in.
+static void readGamepad(void) {
     struct input_event events[32];
-    int32_t bytesRead = read(gamepadData.fd, events, sizeof(events));
+    bool changed = false;
+    bool stickChanged = false;
+    int64_t changeTime = 0;
+    ssize_t bytesRead = 0;
 
-    if (bytesRead >= 0) {
-        int32_t numEvents = bytesRead / sizeof(struct input_event);
+    while ((bytesRead = read(gamepadData.fd, events, sizeof(events))) > 0 || (bytesRead == -1 && errno == EINTR)) {
+        int32_t numEvents = bytesRead > 0 ? bytesRead / sizeof(struct input_event) : 0;
 
         for (int32_t i = 0; i < numEvents; ++i) {
             struct input_event* event = events + i;
-            switch (event->type) {
-                case EV_ABS: {
-                    switch (event->code) {
-                        case ABS_X: gamepadData.stickX = event->value; break;
-                        case ABS_Y: gamepadData.stickY = event->value; break;
-                    }
-                    float x = gamepadData.stickX;
-                    float y = gamepadData.stickY;
-
-                    float mag = (float) sqrt(x * x + y * y);
-                    x /= mag;
-                    y /= mag;
-
-                    if (mag > SPACE_SHOOTER_GAMEPAD_STICK_DEADZONE) {
-                        mag -= SPACE_SHOOTER_GAMEPAD_STICK_DEADZONE;
-                        mag /= 32767.0f - SPACE_SHOOTER_GAMEPAD_STICK_DEADZONE;
-                        gamepad->stickX = x * mag;
-                        gamepad->stickY = -y * mag;
-                    } else {
-                        gamepad->stickX = 0.0f;
-                        gamepad->stickY = 0.0f;
-                    }
+            bool stick = event->type == EV_ABS && (event->code == ABS_X || event->code == ABS_Y);
+            bool button = event->type == EV_KEY && (event->code == BTN_A || event->code == BTN_START || event->code == BTN_SELECT);
 
-                } break;
-                case EV_KEY: {
-                    switch (event->code) {
-                        case BTN_A: gamepad->aButton = event->value; break;
-                        case BTN_START: gamepad->startButton = event->value; break;
-                        case BTN_SELECT: gamepad->backButton = event->value; break;
+            if (!stick && !button) {
+                continue;
+            }
+
+            int64_t time = eventTime(event);
+
+            if (!changed) {
+                changeTime = time;
+                changed = true;
+            }
+
+            GamepadState* state = &gamepadData.state;
+            bool pressed = event->value != 0;
+
+            switch (event->code) {
+                case ABS_X: gamepadData.stickX = event->value; stickChanged = true; break;
+                case ABS_Y: gamepadData.stickY = event->value; stickChanged = true; break;
+                case BTN_A: updateAButton(pressed, time); break;
+                case BTN_START: updateButton(&state->startButton, &state->startPresses, pressed); break;
+                case BTN_SELECT: updateButton(&state->backButton, &state->backPresses, pressed); break;
+            }
+        }
+    }
+
+    if (stickChanged) {
+        updateStick();
+    }
+
+    if (changed) {
+        publishState(changeTime);
+    }
+
+    // Another gamepad may already be connected, so probe for it.
+    if (bytesRead == -1 && errno != EWOULDBLOCK && errno != EAGAIN) {
+        disconnectGamepad();
+        connectGamepad();
+    }
+}
+
+static void* inputThread(void* data) {
+    connectGamepad();
+
+    while (true) {
+        struct epoll_event ready[MAX_EVENTS];
+        int32_t numReady = epoll_wait(gamepadData.epollFd, ready, MAX_EVENTS, -1);
+
+        if (numReady == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            DEBUG_LOG("inputThread: epoll_wait failed. No more gamepad input.");
+            break;
+        }
+
+        bool devicesChanged = false;
+
+        for (int32_t i = 0; i < numReady; ++i) {
+            switch (ready[i].data.u32) {
+                case EVENT_SOURCE_WAKE: return NULL;
+                case EVENT_SOURCE_HOTPLUG: devicesChanged = readHotplug() || devicesChanged; break;
+                case EVENT_SOURCE_GAMEPAD: {
+                    if (gamepadData.fd != -1) {
+                        readGamepad();
                     }
                 } break;
             }
         }
-        gamepad->keyboard = false;
-    } else if (errno != EWOULDBLOCK && errno != EAGAIN) {
-        gamepadData.fd = -1;
+
+        if (devicesChanged && gamepadData.fd == -1) {
+            connectGamepad();
+        }
+    }
+
+    return NULL;
+}
+
+void linux_initGamepad(void) {
+    gamepadData.epollFd = epoll_create1(EPOLL_CLOEXEC);
+
+    if (gamepadData.epollFd == -1) {
+        DEBUG_LOG("linux_initGamepad: Failed to create epoll instance.");
+        goto ERROR_NO_RESOURCES;
+    }
+
+    gamepadData.wakeFd = eventfd(0, EFD_CLOEXEC);
+
+    if (gamepadData.wakeFd == -1 || !addFd(gamepadData.wakeFd, EVENT_SOURCE_WAKE)) {
+        DEBUG_LOG("linux_initGamepad: Failed to create wake fd.");
+        goto ERROR_EPOLL;
+    }
+
+    gamepadData.inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+    if (gamepadData.inotifyFd != -1 && (inotify_add_watch(gamepadData.inotifyFd, DEVICE_DIR, IN_CREATE | IN_ATTRIB) == -1 || !addFd(gamepadData.inotifyFd, EVENT_SOURCE_HOTPLUG))) {
+        close(gamepadData.inotifyFd);
+        gamepadData.inotifyFd = -1;
+    }
+
+    if (gamepadData.inotifyFd == -1) {
+        DEBUG_LOG("linux_initGamepad: Unable to watch for gamepads. Only checking at startup.");
+    } else {
+        watchInputDir();
+    }
+
+    if (pthread_create(&gamepadData.thread, NULL, inputThread, NULL) != 0) {
+        DEBUG_LOG("linux_initGamepad: Failed to start input thread.");
+        goto ERROR_INOTIFY;
+    }
+
+    gamepadData.started = true;
+
+    return;
+
+    ERROR_INOTIFY:
+    if (gamepadData.inotifyFd != -1) {
+        close(gamepadData.inotifyFd);
+        gamepadData.inotifyFd = -1;
+        gamepadData.inputDirWatch = -1;
+    }
+
+    ERROR_EPOLL:
+    if (gamepadData.wakeFd != -1) {
+        close(gamepadData.wakeFd);
+        gamepadData.wakeFd = -1;
+    }
+
+    close(gamepadData.epollFd);
+    gamepadData.epollFd = -1;
+
+    ERROR_NO_RESOURCES:
+    DEBUG_LOG("linux_initGamepad: Gamepad support unavailable.");
+}
+
+void linux_updateGamepad(Linux_Gamepad* gamepad) {
+    GamepadState state;
+    uint32_t sequence = readState(&state);
+    bool updated = sequence != reader.sequence;
+
+    if (updated) {
+        atomic_store_explicit(&published.consumed, sequence, memory_order_release);
+    }
+
+    if (!state.connected) {
+        reader.sequence = sequence;
         gamepad->keyboard = true;
+        return;
+    }
+
+    // A Start or Back press that was released again before
+    // this update still shows up as pressed for one update,
+    // so the state is applied again on the next one even if
+    // nothing new was published. A presses don't need this,
+    // since they're passed on as events.
+    if (!updated && !reader.latched) {
+        return;
+    }
+
+    // Older events have been overwritten in the ring.
+    uint32_t newEvents = state.aEventCount - reader.aEventCount;
+
+    if (newEvents > GAME_INPUT_MAX_EVENTS) {
+        newEvents = GAME_INPUT_MAX_EVENTS;
+    }
+
+    for (uint32_t i = state.aEventCount - newEvents; i != state.aEventCount; ++i) {
+        linux_addShootEvent(gamepad, state.aEvents + i % GAME_INPUT_MAX_EVENTS);
+    }
+
+    bool startPressed = state.startButton || state.startPresses != reader.startPresses;
+    bool backPressed = state.backButton || state.backPresses != reader.backPresses;
+
+    gamepad->stickX = state.stickX;
+    gamepad->stickY = state.stickY;
+    gamepad->aButton = state.aButton;
+    gamepad->startButton = startPressed;
+    gamepad->backButton = backPressed;
+    gamepad->keyboard = false;
+
+    if (updated && !gamepad->time) {
+        gamepad->time = state.time;
     }
+
+    reader.latched = startPressed != state.startButton || backPressed != state.backButton;
+    reader.sequence = sequence;
+    reader.aEventCount = state.aEventCount;
+    reader.startPresses = state.startPresses;
+    reader.backPresses = state.backPresses;
+}
+
+// If the queue is full, the event is dropped. The game
+// still gets the current shoot state from aButton.
+void linux_addShootEvent(Linux_Gamepad* gamepad, Game_InputEvent* event) {
+    if (gamepad->shootEventCount == GAME_INPUT_MAX_EVENTS) {
+        return;
+    }
+
+    gamepad->shootEvents[gamepad->shootEventCount] = *event;
+    ++gamepad->shootEventCount;
 }
 
 void linux_closeGamepad(void) {
+    if (gamepadData.started) {
+        uint64_t wake = 1;
+        write(gamepadData.wakeFd, &wake, sizeof(wake));
+        pthread_join(gamepadData.thread, NULL);
+        gamepadData.started = false;
+    }
+
     if (gamepadData.fd != -1) {
         close(gamepadData.fd);
         gamepadData.fd = -1;
     }
+
+    if (gamepadData.inotifyFd != -1) {
+        close(gamepadData.inotifyFd);
+        gamepadData.inotifyFd = -1;
+        gamepadData.inputDirWatch = -1;
+    }
+
+    if (gamepadData.wakeFd != -1) {
+        close(gamepadData.wakeFd);
+        gamepadData.wakeFd = -1;
+    }
+
+    if (gamepadData.epollFd != -1) {
+        close(gamepadData.epollFd);
+        gamepadData.epollFd = -1;
+    }
 }
@@ -45,6 +45,12 @@
 // - startButton: Whether the Start button being pressed.
 // - backButton: Whether the Back button being pressed.
 // - keyboard: Whether this input came from the keyboard.
+// - time: When the input first changed since it was last
+//      consumed (ns, CLOCK_MONOTONIC), or 0 if it hasn't.
+// - shootEvents: Presses and releases of the A button (or the
+//      keyboard equivalent) since they were last consumed, for
+//      Game_Input.events.
+// - shootEventCount: Number of shootEvents.
 //////////////////////////////////////////////////////////////////////
 
 typedef struct {
@@ -54,18 +60,32 @@ typedef struct {
     bool startButton;
     bool backButton;
     bool keyboard;
+    int64_t time;
+    Game_InputEvent shootEvents[GAME_INPUT_MAX_EVENTS];
+    int32_t shootEventCount;
 } Linux_Gamepad;
 
 //////////////////////////////////////////////////////////////////
 // Linux gamepad controls functions.
 //
-// - linux_detectGamepad(): Attempt to connect to a gamepad.
-// - linux_updateGamepad(): Capture current gamepad state.
-// - linux_closeGamepad(): Release gamepad resources.
+// - linux_initGamepad(): Start the input thread, which
+//      connects to a gamepad, reads its events and watches
+//      for gamepads being connected.
+// - linux_updateGamepad(): Apply the latest gamepad state
+//      published by the input thread. Makes no syscalls, and
+//      should be called once per frame, since a Start or Back
+//      press that was released since the last call shows up
+//      as pressed for one call. A presses and releases are
+//      added to `gamepad`'s shootEvents.
+// - linux_addShootEvent(): Add an A button press or release to
+//      `gamepad`'s shootEvents, dropping it if they're full.
+// - linux_closeGamepad(): Stop the input thread and release
+//      gamepad resources.
 //////////////////////////////////////////////////////////////////
 
-void linux_detectGamepad(void);
+void linux_initGamepad(void);
 void linux_updateGamepad(Linux_Gamepad* gamepad);
+void linux_addShootEvent(Linux_Gamepad* gamepad, Game_InputEvent* event);
 void linux_closeGamepad(void);
 
 #endif
@@ -0,0 +1,233 @@
+////////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+// 
+// Copyright (c) 2021 Tarek Sherif
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "../../shared/platform-interface.h"
+#include "../../shared/debug.h"
+#include "linux-jobs.h"
+
+#define MAX_WORKERS 8
+#define MAX_JOBS 32
+
+typedef struct {
+    void (*function)(void* data);
+    void* data;
+    enum {
+        JOB_FREE,
+        JOB_QUEUED,
+        JOB_RUNNING,
+        JOB_DONE
+    } state;
+} Job;
+
+//////////////////////////////////////////////////////////
+// Job ids are indices into the jobs array. Queued ids
+// are kept in a ring so they run in submission order.
+// Everything is guarded by the pool lock, except a
+// running job's function and data, which don't change
+// until it's done.
+//////////////////////////////////////////////////////////
+
+static struct {
+    pthread_t workers[MAX_WORKERS];
+    int32_t workerCount;
+    Job jobs[MAX_JOBS];
+    int32_t queue[MAX_JOBS];
+    int32_t queueHead;
+    int32_t queueCount;
+    pthread_mutex_t lock;
+    pthread_cond_t jobAdded;
+    pthread_cond_t jobDone;
+    bool shutdown;
+    bool initialized;
+} pool;
+
+static void* worker(void* arg) {
+    pthread_mutex_lock(&pool.lock);
+
+    while (true) {
+        while (pool.queueCount == 0 && !pool.shutdown) {
+            pthread_cond_wait(&pool.jobAdded, &pool.lock);
+        }
+
+        if (pool.shutdown) {
+            break;
+        }
+
+        Job* job = pool.jobs + pool.queue[pool.queueHead];
+        pool.queueHead = (pool.queueHead + 1) % MAX_JOBS;
+        --pool.queueCount;
+        job->state = JOB_RUNNING;
+
+        pthread_mutex_unlock(&pool.lock);
+        job->function(job->data);
+        pthread_mutex_lock(&pool.lock);
+
+        job->state = JOB_DONE;
+        pthread_cond_broadcast(&pool.jobDone);
+    }
+
+    pthread_mutex_unlock(&pool.lock);
+
+    return NULL;
+}
+
+bool linux_initJobs(void) {
+    int32_t workerCount = sysconf(_SC_NPROCESSORS_ONLN) - 1;
+
+    if (workerCount < 1) {
+        workerCount = 1;
+    }
+
+    if (workerCount > MAX_WORKERS) {
+        workerCount = MAX_WORKERS;
+    }
+
+    if (pthread_mutex_init(&pool.lock, NULL)) {
+        goto ERROR_NO_RESOURCES;
+    }
+
+    if (pthread_cond_init(&pool.jobAdded, NULL)) {
+        goto ERROR_LOCK;
+    }
+
+    if (pthread_cond_init(&pool.jobDone, NULL)) {
+        goto ERROR_JOB_ADDED;
+    }
+
+    // Run with however many workers could be started.
+    while (pool.workerCount < workerCount) {
+        if (pthread_create(pool.workers + pool.workerCount, NULL, worker, NULL)) {
+            DEBUG_LOG("linux_initJobs: Failed to start worker.");
+            break;
+        }
+
+        ++pool.workerCount;
+    }
+
+    if (pool.workerCount == 0) {
+        goto ERROR_JOB_DONE;
+    }
+
+    pool.initialized = true;
+
+    return true;
+
+    ERROR_JOB_DONE:
+    pthread_cond_destroy(&pool.jobDone);
+
+    ERROR_JOB_ADDED:
+    pthread_cond_destroy(&pool.jobAdded);
+
+    ERROR_LOCK:
+    pthread_mutex_destroy(&pool.lock);
+
+    ERROR_NO_RESOURCES:
+    return false;
+}
+
+void linux_closeJobs(void) {
+    if (!pool.initialized) {
+        return;
+    }
+
+    pthread_mutex_lock(&pool.lock);
+    pool.shutdown = true;
+    pthread_cond_broadcast(&pool.jobAdded);
+    pthread_mutex_unlock(&pool.lock);
+
+    for (int32_t i = 0; i < pool.workerCount; ++i) {
+        pthread_join(pool.workers[i], NULL);
+    }
+
+    pthread_cond_destroy(&pool.jobDone);
+    pthread_cond_destroy(&pool.jobAdded);
+    pthread_mutex_destroy(&pool.lock);
+
+    pool.workerCount = 0;
+    pool.initialized = false;
+}
+
+int32_t platform_addJob(void (*function)(void* data), void* data) {
+    if (!pool.initialized) {
+        return -1;
+    }
+
+    pthread_mutex_lock(&pool.lock);
+
+    int32_t id = -1;
+    for (int32_t i = 0; i < MAX_JOBS; ++i) {
+        if (pool.jobs[i].state == JOB_FREE) {
+            id = i;
+            break;
+        }
+    }
+
+    if (id != -1) {
+        pool.jobs[id].function = function;
+        pool.jobs[id].data = data;
+        pool.jobs[id].state = JOB_QUEUED;
+        pool.queue[(pool.queueHead + pool.queueCount) % MAX_JOBS] = id;
+        ++pool.queueCount;
+        pthread_cond_signal(&pool.jobAdded);
+    }
+
+    pthread_mutex_unlock(&pool.lock);
+
+    return id;
+}
+
+bool platform_jobComplete(int32_t id) {
+    if (id < 0) {
+        return true;
+    }
+
+    pthread_mutex_lock(&pool.lock);
+
+    bool done = pool.jobs[id].state == JOB_DONE;
+    if (done) {
+        pool.jobs[id].state = JOB_FREE;
+    }
+
+    pthread_mutex_unlock(&pool.lock);
+
+    return done;
+}
+
+void platform_waitForJob(int32_t id) {
+    if (id < 0) {
+        return;
+    }
+
+    pthread_mutex_lock(&pool.lock);
+
+    while (pool.jobs[id].state != JOB_DONE) {
+        pthread_cond_wait(&pool.jobDone, &pool.lock);
+    }
+
+    pool.jobs[id].state = JOB_FREE;
+
+    pthread_mutex_unlock(&pool.lock);
+}
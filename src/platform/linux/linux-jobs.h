@@ -0,0 +1,40 @@
+////////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+// 
+// Copyright (c) 2021 Tarek Sherif
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _LINUX_JOBS_H_
+#define _LINUX_JOBS_H_
+
+//////////////////////////////////////////////////////////////////
+// Initialization and cleanup functions for the Linux worker
+// pool that runs jobs submitted with platform_addJob().
+//
+// - linux_initJobs(): Start one worker per core, leaving one
+//      for the main thread.
+// - linux_closeJobs(): Wait for running jobs to finish and
+//      terminate the workers. Jobs still queued are never run.
+//////////////////////////////////////////////////////////////////
+
+bool linux_initJobs(void);
+void linux_closeJobs(void);
+
+#endif
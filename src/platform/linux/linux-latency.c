@@ -0,0 +1,178 @@
+////////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+// 
+// Copyright (c) 2021 Tarek Sherif
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include "../../shared/constants.h"
+#include "../../shared/debug.h"
+#include "linux-pacer.h"
+#include "linux-latency.h"
+#include "linux-time.h"
+
+#define NUM_BUCKETS 100 // 1ms each, the last one also counts anything longer
+#define MAX_PENDING_SWAPS 8
+
+typedef struct {
+    const char* name;
+    int64_t buckets[NUM_BUCKETS];
+    int64_t count;
+    int64_t total;
+    int64_t max;
+} Histogram;
+
+// Swaps are tracked by their swap buffer count (SBC),
+// which completion events report back.
+typedef struct {
+    int64_t sbc;
+    int64_t inputTime;
+} PendingSwap;
+
+static struct {
+    int32_t swapEventType; // -1 if swap events aren't supported
+    int64_t swapCount;
+    int64_t lastInputTime;
+    PendingSwap pending[MAX_PENDING_SWAPS];
+    Histogram swapReturn;
+    Histogram swapComplete;
+} latency = {
+    .swapEventType = -1,
+    .swapReturn = { .name = "swap-return" },
+    .swapComplete = { .name = "swap-complete" }
+};
+
+static void record(Histogram* histogram, int64_t time) {
+    if (time < 0) {
+        return;
+    }
+
+    int64_t bucket = time / SPACE_SHOOTER_MILLISECOND;
+
+    if (bucket >= NUM_BUCKETS) {
+        bucket = NUM_BUCKETS - 1;
+    }
+
+    ++histogram->buckets[bucket];
+    ++histogram->count;
+    histogram->total += time;
+
+    if (time > histogram->max) {
+        histogram->max = time;
+    }
+}
+
+// Upper edge of the bucket the percentile falls in.
+static int32_t percentile(Histogram* histogram, int32_t percent) {
+    int64_t target = (histogram->count * percent + 99) / 100;
+    int64_t count = 0;
+
+    for (int32_t i = 0; i < NUM_BUCKETS; ++i) {
+        count += histogram->buckets[i];
+
+        if (count >= target) {
+            return i + 1;
+        }
+    }
+
+    return NUM_BUCKETS;
+}
+
+static void report(Histogram* histogram) {
+    if (histogram->count == 0) {
+        printf("latency stage=%s samples=0\n", histogram->name);
+        return;
+    }
+
+    printf(
+        "latency stage=%s samples=%lld mean_ms=%.2f p50_ms=%d p95_ms=%d p99_ms=%d max_ms=%.2f\n",
+        histogram->name,
+        (long long) histogram->count,
+        (double) histogram->total / histogram->count / SPACE_SHOOTER_MILLISECOND,
+        percentile(histogram, 50),
+        percentile(histogram, 95),
+        percentile(histogram, 99),
+        (double) histogram->max / SPACE_SHOOTER_MILLISECOND
+    );
+
+    for (int32_t i = 0; i < NUM_BUCKETS; ++i) {
+        if (histogram->buckets[i] > 0) {
+            printf("latency stage=%s bucket_ms=%d count=%lld\n", histogram->name, i, (long long) histogram->buckets[i]);
+        }
+    }
+}
+
+void linux_initLatency(Display* display, GLXDrawable window) {
+    int32_t errorBase = 0;
+    int32_t eventBase = 0;
+
+    if (!linux_hasGLXExtension(display, "GLX_INTEL_swap_event") || !glXQueryExtension(display, &errorBase, &eventBase)) {
+        DEBUG_LOG("linux_initLatency: Swap events not supported. Only measuring to swap return.");
+        return;
+    }
+
+    glXSelectEvent(display, window, GLX_BUFFER_SWAP_COMPLETE_INTEL_MASK);
+    latency.swapEventType = eventBase + GLX_BufferSwapComplete;
+}
+
+// Each new stamp is only measured on the first frame it appears in.
+void linux_framePresented(int64_t inputTime) {
+    int64_t time = linux_currentTime();
+    bool newInput = inputTime != 0 && inputTime != latency.lastInputTime;
+
+    ++latency.swapCount;
+
+    latency.pending[latency.swapCount % MAX_PENDING_SWAPS] = (PendingSwap) {
+        .sbc = latency.swapCount,
+        .inputTime = newInput ? inputTime : 0
+    };
+
+    if (newInput) {
+        record(&latency.swapReturn, time - inputTime);
+        latency.lastInputTime = inputTime;
+    }
+}
+
+// UST is in microseconds on CLOCK_MONOTONIC with the
+// Mesa drivers that support swap events.
+bool linux_handleLatencyEvent(XEvent* event) {
+    if (event->type != latency.swapEventType) {
+        return false;
+    }
+
+    GLXBufferSwapComplete* swapEvent = (GLXBufferSwapComplete *) event;
+    PendingSwap* swap = latency.pending + swapEvent->sbc % MAX_PENDING_SWAPS;
+
+    if (swap->sbc == swapEvent->sbc && swap->inputTime != 0) {
+        record(&latency.swapComplete, swapEvent->ust * 1000 - swap->inputTime);
+    }
+
+    return true;
+}
+
+void linux_reportLatency(void) {
+    report(&latency.swapReturn);
+
+    if (latency.swapEventType != -1) {
+        report(&latency.swapComplete);
+    }
+
+    fflush(stdout);
+}
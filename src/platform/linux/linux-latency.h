@@ -0,0 +1,54 @@
+////////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+// 
+// Copyright (c) 2021 Tarek Sherif
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _LINUX_LATENCY_H_
+#define _LINUX_LATENCY_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <X11/Xlib.h>
+#include <GL/glx.h>
+
+//////////////////////////////////////////////////////////////////
+// Input latency measurement for Linux. Input is stamped when it
+// arrives (see Game_Input), and each frame that first reflects
+// a new stamp is measured up to the swap returning and, if
+// GLX_INTEL_swap_event is supported, up to the swap completing.
+// Measurements are collected in histograms with 1ms buckets.
+//
+// - linux_initLatency(): Request swap completion events for
+//      `window`, if supported.
+// - linux_framePresented(): Record a frame that was just
+//      swapped, drawn with input stamped `inputTime` (see
+//      game_drawnInputTime()).
+// - linux_handleLatencyEvent(): Handle an X event if it's a
+//      swap completion event. Returns false if it isn't.
+// - linux_reportLatency(): Print the histograms.
+//////////////////////////////////////////////////////////////////
+
+void linux_initLatency(Display* display, GLXDrawable window);
+void linux_framePresented(int64_t inputTime);
+bool linux_handleLatencyEvent(XEvent* event);
+void linux_reportLatency(void);
+
+#endif
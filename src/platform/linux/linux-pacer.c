@@ -0,0 +1,157 @@
+////////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+// 
+// Copyright (c) 2021 Tarek Sherif
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <string.h>
+#include "../../shared/constants.h"
+#include "../../shared/debug.h"
+#include "linux-pacer.h"
+#include "linux-time.h"
+
+#define DEFAULT_REFRESH_RATE 60
+#define BACKGROUND_FRAME_PERIOD (100 * SPACE_SHOOTER_MILLISECOND)
+#define WAKE_MARGIN SPACE_SHOOTER_MILLISECOND // Covers wakeup latency and GPU time
+#define WORK_DECAY 32 // Work estimate decays by 1/WORK_DECAY each frame
+
+typedef void (*glXSwapIntervalEXTFUNC)(Display* display, GLXDrawable window, int32_t interval);
+typedef Bool (*glXGetMscRateOMLFUNC)(Display* display, GLXDrawable drawable, int32_t* numerator, int32_t* denominator);
+
+static struct {
+    Display* display;
+    GLXDrawable window;
+    int64_t framePeriod;
+    int64_t nextSwap;     // When the next swap is expected to complete
+    int64_t deadline;     // When the next frame is meant to start
+    int64_t waitStart;    // When the caller started waiting for the deadline
+    int64_t frameStart;   // When the frame was meant to start
+    int64_t workEstimate; // Time from frameStart to submitting a frame
+    bool background;
+} pacer;
+
+// Extension names are matched as whole words in the space-separated list.
+bool linux_hasGLXExtension(Display* display, const char* name) {
+    const char* extensions = glXQueryExtensionsString(display, DefaultScreen(display));
+
+    if (!extensions) {
+        return false;
+    }
+
+    size_t length = strlen(name);
+    const char* match = extensions;
+
+    while ((match = strstr(match, name))) {
+        bool start = match == extensions || match[-1] == ' ';
+        bool end = match[length] == ' ' || match[length] == '\0';
+
+        if (start && end) {
+            return true;
+        }
+
+        match += length;
+    }
+
+    return false;
+}
+
+void linux_initPacer(Display* display, GLXDrawable window) {
+    pacer.display = display;
+    pacer.window = window;
+    pacer.framePeriod = SPACE_SHOOTER_SECOND / DEFAULT_REFRESH_RATE;
+    pacer.nextSwap = 0;
+    pacer.workEstimate = 0;
+
+    //////////////////////////////////////////////////////
+    // Adaptive vsync (swap interval -1) tears instead of
+    // waiting a whole extra refresh when a frame is late.
+    //////////////////////////////////////////////////////
+
+    glXSwapIntervalEXTFUNC glXSwapIntervalEXT = (glXSwapIntervalEXTFUNC) glXGetProcAddress((const GLubyte *) "glXSwapIntervalEXT");
+
+    if (glXSwapIntervalEXT) {
+        glXSwapIntervalEXT(display, window, linux_hasGLXExtension(display, "GLX_EXT_swap_control_tear") ? -1 : 1);
+    }
+
+    glXGetMscRateOMLFUNC glXGetMscRateOML = NULL;
+
+    if (linux_hasGLXExtension(display, "GLX_OML_sync_control")) {
+        glXGetMscRateOML = (glXGetMscRateOMLFUNC) glXGetProcAddress((const GLubyte *) "glXGetMscRateOML");
+    }
+
+    int32_t numerator = 0;
+    int32_t denominator = 0;
+
+    if (glXGetMscRateOML && glXGetMscRateOML(display, window, &numerator, &denominator) && numerator > 0 && denominator > 0) {
+        pacer.framePeriod = SPACE_SHOOTER_SECOND * denominator / numerator;
+    } else {
+        DEBUG_LOG("linux_initPacer: Unable to query refresh rate. Assuming 60Hz.");
+    }
+}
+
+int64_t linux_frameDeadline(bool background) {
+    pacer.background = background;
+    pacer.waitStart = linux_currentTime();
+
+    if (background) {
+        pacer.deadline = pacer.waitStart + BACKGROUND_FRAME_PERIOD;
+    } else {
+        pacer.deadline = pacer.nextSwap - pacer.workEstimate - WAKE_MARGIN;
+    }
+
+    return pacer.deadline;
+}
+
+// If the deadline had already passed when waiting started,
+// the frame is counted from then instead.
+int64_t linux_beginFrame(void) {
+    pacer.frameStart = pacer.deadline > pacer.waitStart ? pacer.deadline : pacer.waitStart;
+
+    return linux_currentTime();
+}
+
+//////////////////////////////////////////////////////
+// Work is measured up to submitting the frame, since
+// with vsync, the swap itself blocks until the vblank.
+// It's measured from when the frame was meant to
+// start, so waking up late counts as well. The
+// estimate tracks the recent worst case, decaying
+// slowly so a single slow frame doesn't add latency
+// for long. With vsync, the swap completes just after
+// a vblank, so the next one is a refresh later.
+// Without it, this paces frames to the refresh rate.
+//////////////////////////////////////////////////////
+
+void linux_presentFrame(void) {
+    if (!pacer.background) {
+        int64_t work = linux_currentTime() - pacer.frameStart;
+
+        pacer.workEstimate -= pacer.workEstimate / WORK_DECAY;
+
+        if (work > pacer.workEstimate) {
+            pacer.workEstimate = work < pacer.framePeriod ? work : pacer.framePeriod;
+        }
+    }
+
+    glXSwapBuffers(pacer.display, pacer.window);
+
+    pacer.nextSwap = linux_currentTime() + pacer.framePeriod;
+}
@@ -0,0 +1,63 @@
+////////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+// 
+// Copyright (c) 2021 Tarek Sherif
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _LINUX_PACER_H_
+#define _LINUX_PACER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <X11/Xlib.h>
+#include <GL/glx.h>
+
+//////////////////////////////////////////////////////////////////
+// Frame pacing for Linux. Rather than sleeping a fixed minimum
+// frame time, the main loop sleeps until an absolute deadline
+// derived from the display's refresh rate, leaving just enough
+// time to poll input, update, draw and swap before the next
+// vblank. This keeps input as fresh as possible when it's
+// drawn and avoids spinning on the swap.
+//
+// - linux_initPacer(): Set the swap interval (adaptive vsync
+//      if supported) and query the refresh rate for `window`.
+//      Must be called with the window's context current.
+// - linux_frameDeadline(): Get the time (ns, CLOCK_MONOTONIC)
+//      to start the next frame, which the caller should wait
+//      for (see linux-events.h). In the past before the first
+//      frame. In the background, frames are paced to a low
+//      fixed rate instead of the display's, and don't count
+//      towards the work estimate.
+// - linux_beginFrame(): Mark the start of the frame once the
+//      deadline has been waited for. Returns the current time.
+// - linux_presentFrame(): Swap buffers and schedule the next
+//      frame.
+// - linux_hasGLXExtension(): Check whether a GLX extension is
+//      supported on `display`'s default screen.
+//////////////////////////////////////////////////////////////////
+
+void linux_initPacer(Display* display, GLXDrawable window);
+int64_t linux_frameDeadline(bool background);
+int64_t linux_beginFrame(void);
+void linux_presentFrame(void);
+bool linux_hasGLXExtension(Display* display, const char* name);
+
+#endif
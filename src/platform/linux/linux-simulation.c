@@ -0,0 +1,223 @@
+////////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+// 
+// Copyright (c) 2021 Tarek Sherif
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////////
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../../shared/constants.h"
+#include "../../shared/platform-interface.h"
+#include "../../shared/debug.h"
+#include "linux-simulation.h"
+#include "linux-startup.h"
+#include "linux-time.h"
+
+#define PAUSED_SLEEP_TIME (100 * SPACE_SHOOTER_MILLISECOND)
+#define BENCHMARK_OUTPUT_SIZE 4096
+#define BENCHMARK_ARGUMENT_LENGTH 32
+#define BENCHMARK_ROUNDS 5
+
+static const int32_t BENCHMARK_TICK_RATES[] = { 60, 120, 240 };
+#define NUM_BENCHMARK_TICK_RATES (int32_t) (sizeof(BENCHMARK_TICK_RATES) / sizeof(BENCHMARK_TICK_RATES[0]))
+
+static struct {
+    pthread_t thread;
+    atomic_bool running;
+    atomic_bool paused;
+    bool started;
+} simulation;
+
+// Sleeps to an absolute deadline so time spent simulating
+// doesn't push later ticks back.
+static void* simulationThread(void* data) {
+    int64_t lastTime = linux_currentTime();
+    bool wasPaused = false;
+
+    while (atomic_load(&simulation.running)) {
+        int64_t time = linux_currentTime();
+        int64_t deadline = time + PAUSED_SLEEP_TIME;
+        bool paused = atomic_load(&simulation.paused);
+
+        // Time spent paused isn't simulated.
+        if (!paused) {
+            float elapsedTime = wasPaused ? 0.0f : (float) (time - lastTime) / SPACE_SHOOTER_MILLISECOND;
+            float untilNextTick = game_simulate(elapsedTime);
+            deadline = time + (int64_t) (untilNextTick * SPACE_SHOOTER_MILLISECOND);
+        }
+
+        lastTime = time;
+        wasPaused = paused;
+
+        struct timespec deadlineSpec = {
+            .tv_sec = deadline / SPACE_SHOOTER_SECOND,
+            .tv_nsec = deadline % SPACE_SHOOTER_SECOND
+        };
+
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadlineSpec, NULL) == EINTR);
+    }
+
+    return NULL;
+}
+
+bool linux_startSimulation(void) {
+    atomic_store(&simulation.running, true);
+
+    if (pthread_create(&simulation.thread, NULL, simulationThread, NULL)) {
+        DEBUG_LOG("linux_startSimulation: Failed to start simulation thread.");
+        atomic_store(&simulation.running, false);
+        return false;
+    }
+
+    simulation.started = true;
+
+    return true;
+}
+
+void linux_pauseSimulation(bool paused) {
+    atomic_store(&simulation.paused, paused);
+}
+
+void linux_stopSimulation(void) {
+    if (!simulation.started) {
+        return;
+    }
+
+    atomic_store(&simulation.running, false);
+    pthread_join(simulation.thread, NULL);
+    simulation.started = false;
+}
+
+//////////////////////////////////////////////////////////
+// Measures thread CPU time rather than wall time, so
+// being preempted doesn't count against a run. Each call
+// gets exactly the time to the next tick, so every call
+// runs one tick and publishes one snapshot, as the
+// simulation thread does when it keeps up.
+//////////////////////////////////////////////////////////
+
+static int64_t cpuTime(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+
+    return time.tv_sec * SPACE_SHOOTER_SECOND + time.tv_nsec;
+}
+
+int32_t linux_benchmarkSimulation(float seconds, int32_t tickRate) {
+    double gameTime = seconds * 1000.0;
+    double simulatedTime = 0.0;
+    float untilNextTick = game_simulate(0.0f);
+
+    int64_t start = cpuTime();
+
+    while (simulatedTime < gameTime) {
+        simulatedTime += untilNextTick;
+        untilNextTick = game_simulate(untilNextTick);
+    }
+
+    double cpuMs = (double) (cpuTime() - start) / SPACE_SHOOTER_MILLISECOND;
+    int32_t ticks = (int32_t) (simulatedTime * tickRate / 1000.0 + 0.5);
+
+    printf(
+        "simulation tick_rate=%d ticks=%d cpu_ms=%.2f tick_us=%.2f cost_ms_per_s=%.3f\n",
+        tickRate,
+        ticks,
+        cpuMs,
+        cpuMs * 1000.0 / ticks,
+        cpuMs * 1000.0 / simulatedTime
+    );
+    fflush(stdout);
+
+    return 0;
+}
+
+//////////////////////////////////////////////////////////
+// Run the benchmark at one tick rate in a child process,
+// so each rate starts from a freshly initialized game,
+// and read its cost back from its log.
+//////////////////////////////////////////////////////////
+
+static bool runBenchmark(float seconds, int32_t tickRate, double* cost) {
+    char secondsArgument[BENCHMARK_ARGUMENT_LENGTH];
+    char tickRateArgument[BENCHMARK_ARGUMENT_LENGTH];
+    snprintf(secondsArgument, BENCHMARK_ARGUMENT_LENGTH, "%g", seconds);
+    snprintf(tickRateArgument, BENCHMARK_ARGUMENT_LENGTH, "%d", tickRate);
+
+    char* arguments[] = { "space-shooter", "--tick-rate", tickRateArgument, "--simulation-benchmark-run", secondsArgument, NULL };
+    char log[BENCHMARK_OUTPUT_SIZE];
+
+    if (!linux_runBenchmarkProcess(arguments, log, BENCHMARK_OUTPUT_SIZE)) {
+        return false;
+    }
+
+    const char* result = strstr(log, "cost_ms_per_s=");
+
+    if (!result) {
+        return false;
+    }
+
+    fputs(log, stdout);
+    *cost = strtod(result + strlen("cost_ms_per_s="), NULL);
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////
+// Each run plays out differently (enemies spawn
+// randomly), so rates are run in interleaved rounds and
+// each rate's cheapest run is reported, to keep noise
+// from other processes and CPU clocks out of the ratios.
+//////////////////////////////////////////////////////////
+
+int32_t linux_runSimulationBenchmark(float seconds) {
+    double costs[NUM_BENCHMARK_TICK_RATES];
+
+    for (int32_t round = 0; round < BENCHMARK_ROUNDS; ++round) {
+        for (int32_t i = 0; i < NUM_BENCHMARK_TICK_RATES; ++i) {
+            double cost = 0.0;
+
+            if (!runBenchmark(seconds, BENCHMARK_TICK_RATES[i], &cost)) {
+                fprintf(stderr, "Simulation benchmark at %d Hz failed.\n", BENCHMARK_TICK_RATES[i]);
+                return 1;
+            }
+
+            if (round == 0 || cost < costs[i]) {
+                costs[i] = cost;
+            }
+        }
+    }
+
+    for (int32_t i = 0; i < NUM_BENCHMARK_TICK_RATES; ++i) {
+        printf(
+            "benchmark tick_rate=%d cost_ms_per_s=%.3f relative=%.2f linear=%.2f\n",
+            BENCHMARK_TICK_RATES[i],
+            costs[i],
+            costs[0] > 0.0 ? costs[i] / costs[0] : 0.0,
+            (double) BENCHMARK_TICK_RATES[i] / BENCHMARK_TICK_RATES[0]
+        );
+    }
+
+    return 0;
+}
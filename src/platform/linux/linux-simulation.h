@@ -0,0 +1,69 @@
+////////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+// 
+// Copyright (c) 2021 Tarek Sherif
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _LINUX_SIMULATION_H_
+#define _LINUX_SIMULATION_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+//////////////////////////////////////////////////////////////////
+// Optional simulation thread for Linux. Runs game_simulate() at
+// the game's tick rate, so simulation ticks aren't delayed by
+// drawing or blocking on the swap. The game must have been
+// initialized with the simulationThread option.
+//
+// - linux_startSimulation(): Start the simulation thread.
+//      Returns false if it couldn't be started, in which case
+//      the main loop should call game_simulate() itself.
+// - linux_pauseSimulation(): Pause or resume the simulation
+//      (e.g. while the window is in the background). Time spent
+//      paused isn't simulated.
+// - linux_stopSimulation(): Stop the simulation thread and
+//      wait for it to exit.
+//
+// Simulation benchmark, reported as a structured log, e.g.:
+//
+//     simulation tick_rate=240 ticks=7200 cpu_ms=61.20 tick_us=8.50 cost_ms_per_s=2.04
+//     benchmark tick_rate=240 cost_ms_per_s=2.04 relative=3.91 linear=4.00
+//
+// - linux_benchmarkSimulation(): Run `seconds` of game time
+//      through game_simulate() as fast as possible, one tick
+//      per call, and print its CPU time. The game must have
+//      been initialized with the simulationThread option and
+//      `tickRate`, and the simulation thread not started.
+//      Returns the process exit status.
+// - linux_runSimulationBenchmark(): Run the simulation
+//      benchmark at 60, 120 and 240 Hz, several times each in
+//      child processes, and report each tick rate's lowest
+//      cost per second of game time relative to 60 Hz.
+//      Returns the process exit status.
+//////////////////////////////////////////////////////////////////
+
+bool linux_startSimulation(void);
+void linux_pauseSimulation(bool paused);
+void linux_stopSimulation(void);
+int32_t linux_benchmarkSimulation(float seconds, int32_t tickRate);
+int32_t linux_runSimulationBenchmark(float seconds);
+
+#endif
@@ -0,0 +1,246 @@
+////////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+// 
+// Copyright (c) 2021 Tarek Sherif
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "../../shared/constants.h"
+#include "../../shared/platform-interface.h"
+#include "linux-startup.h"
+#include "linux-time.h"
+
+#define MAX_STARTUP_PHASES 48
+#define BENCHMARK_OUTPUT_SIZE 8192
+#define BENCHMARK_DISCARD_SIZE 1024
+#define TIME_ARGUMENT_LENGTH 32
+
+static struct {
+    struct {
+        const char* name;
+        int64_t time;
+    } phases[MAX_STARTUP_PHASES];
+    int32_t count;
+    int64_t launchTime;
+    int64_t endTime;
+    bool running;
+} startup;
+
+static double msFromNs(int64_t ns) {
+    return (double) ns / SPACE_SHOOTER_MILLISECOND;
+}
+
+void linux_beginStartup(int64_t launchTime) {
+    int64_t time = linux_currentTime();
+
+    startup.count = 0;
+    startup.running = true;
+    startup.launchTime = launchTime > 0 ? launchTime : time;
+
+    // Time between the benchmark launching the process and main().
+    if (launchTime > 0) {
+        platform_startupPhase("exec");
+        startup.phases[0].time = launchTime;
+    }
+}
+
+void platform_startupPhase(const char* name) {
+    if (!startup.running || startup.count == MAX_STARTUP_PHASES) {
+        return;
+    }
+
+    startup.phases[startup.count].name = name;
+    startup.phases[startup.count].time = linux_currentTime();
+    ++startup.count;
+}
+
+void linux_endStartup(bool report) {
+    if (!startup.running) {
+        return;
+    }
+
+    startup.endTime = linux_currentTime();
+    startup.running = false;
+
+    if (!report) {
+        return;
+    }
+
+    for (int32_t i = 0; i < startup.count; ++i) {
+        int64_t start = startup.phases[i].time;
+        int64_t end = i + 1 < startup.count ? startup.phases[i + 1].time : startup.endTime;
+
+        printf(
+            "startup phase=%s start_ms=%.2f duration_ms=%.2f\n",
+            startup.phases[i].name,
+            msFromNs(start - startup.launchTime),
+            msFromNs(end - start)
+        );
+    }
+
+    printf("startup phase=total duration_ms=%.2f\n", msFromNs(startup.endTime - startup.launchTime));
+    fflush(stdout);
+}
+
+//////////////////////////////////////////////////////////
+// Output that doesn't fit in the log is read and dropped
+// rather than closing the pipe early, which would kill the
+// child with SIGPIPE on its next write.
+//////////////////////////////////////////////////////////
+
+bool linux_runBenchmarkProcess(char* const arguments[], char* log, int32_t logSize) {
+    int32_t output[2];
+
+    if (pipe(output) == -1) {
+        goto ERROR_NO_RESOURCES;
+    }
+
+    pid_t child = fork();
+
+    if (child == -1) {
+        goto ERROR_PIPE;
+    }
+
+    if (child == 0) {
+        dup2(output[1], STDOUT_FILENO);
+        close(output[0]);
+        close(output[1]);
+
+        execv("/proc/self/exe", arguments);
+        _exit(127);
+    }
+
+    close(output[1]);
+
+    char discard[BENCHMARK_DISCARD_SIZE];
+    int32_t length = 0;
+    ssize_t bytes = 0;
+
+    while (true) {
+        bool full = length == logSize - 1;
+        bytes = full ? read(output[0], discard, BENCHMARK_DISCARD_SIZE) : read(output[0], log + length, logSize - 1 - length);
+
+        if (bytes <= 0) {
+            break;
+        }
+
+        if (!full) {
+            length += bytes;
+        }
+    }
+
+    log[length] = '\0';
+    close(output[0]);
+
+    int32_t status = 0;
+    if (waitpid(child, &status, 0) == -1 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        goto ERROR_NO_RESOURCES;
+    }
+
+    return true;
+
+    ERROR_PIPE:
+    close(output[0]);
+    close(output[1]);
+
+    ERROR_NO_RESOURCES:
+    return false;
+}
+
+//////////////////////////////////////////////////////////
+// Run the game once in a child process, passing it the
+// launch time so its log includes process creation, and
+// read its total startup time back from its log.
+//////////////////////////////////////////////////////////
+
+static bool runStartup(double* duration) {
+    char launchTime[TIME_ARGUMENT_LENGTH];
+    snprintf(launchTime, TIME_ARGUMENT_LENGTH, "%lld", (long long) linux_currentTime());
+
+    char* arguments[] = { "space-shooter", "--exit-after-first-frame", "--startup-log", "--launch-time", launchTime, NULL };
+    char log[BENCHMARK_OUTPUT_SIZE];
+
+    if (!linux_runBenchmarkProcess(arguments, log, BENCHMARK_OUTPUT_SIZE)) {
+        return false;
+    }
+
+    const char* total = strstr(log, "startup phase=total duration_ms=");
+
+    if (!total) {
+        return false;
+    }
+
+    fputs(log, stdout);
+    *duration = strtod(total + strlen("startup phase=total duration_ms="), NULL);
+
+    return true;
+}
+
+int32_t linux_runStartupBenchmark(int32_t runs) {
+    double cold = 0.0;
+    double warmMin = 0.0;
+    double warmMax = 0.0;
+    double warmTotal = 0.0;
+
+    //////////////////////////////////////////////////////
+    // The first run is only as cold as the page cache
+    // allows. For a true cold start, drop caches first
+    // (echo 3 > /proc/sys/vm/drop_caches).
+    //////////////////////////////////////////////////////
+
+    for (int32_t i = 0; i < runs; ++i) {
+        double duration = 0.0;
+
+        if (!runStartup(&duration)) {
+            fprintf(stderr, "Startup benchmark run %d failed.\n", i + 1);
+            return 1;
+        }
+
+        printf("benchmark run=%d kind=%s duration_ms=%.2f\n", i + 1, i == 0 ? "cold" : "warm", duration);
+
+        if (i == 0) {
+            cold = duration;
+            continue;
+        }
+
+        if (i == 1 || duration < warmMin) {
+            warmMin = duration;
+        }
+
+        if (duration > warmMax) {
+            warmMax = duration;
+        }
+
+        warmTotal += duration;
+    }
+
+    printf("benchmark kind=cold duration_ms=%.2f\n", cold);
+
+    if (runs > 1) {
+        printf("benchmark kind=warm runs=%d min_ms=%.2f mean_ms=%.2f max_ms=%.2f\n", runs - 1, warmMin, warmTotal / (runs - 1), warmMax);
+    }
+
+    return 0;
+}
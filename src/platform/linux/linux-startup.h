@@ -0,0 +1,59 @@
+////////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+// 
+// Copyright (c) 2021 Tarek Sherif
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _LINUX_STARTUP_H_
+#define _LINUX_STARTUP_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+//////////////////////////////////////////////////////////////////
+// Startup timing for Linux. Phases are recorded with
+// platform_startupPhase() and reported as a structured log,
+// one line per phase, e.g.:
+//
+//     startup phase=renderer-init start_ms=41.20 duration_ms=3.85
+//     startup phase=total duration_ms=97.31
+//
+// - linux_beginStartup(): Start timing from `launchTime` (ns,
+//      CLOCK_MONOTONIC), or from now if it's 0.
+// - linux_endStartup(): End the last phase (after the first
+//      frame is presented) and print the log to stdout if
+//      `report` is set. Later phases are ignored.
+// - linux_runStartupBenchmark(): Launch the game `runs` times,
+//      exiting after the first frame, and report the startup
+//      times of the first (cold) and remaining (warm) runs.
+//      Returns the process exit status.
+// - linux_runBenchmarkProcess(): Run the game in a child process
+//      with `arguments` (argv, NULL-terminated) and capture its
+//      stdout in `log` as a null-terminated string, truncated to
+//      fit `logSize`. Returns true if the child exited with
+//      status 0.
+//////////////////////////////////////////////////////////////////
+
+void linux_beginStartup(int64_t launchTime);
+void linux_endStartup(bool report);
+int32_t linux_runStartupBenchmark(int32_t runs);
+bool linux_runBenchmarkProcess(char* const arguments[], char* log, int32_t logSize);
+
+#endif
@@ -0,0 +1,124 @@
+////////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+// 
+// Copyright (c) 2021 Tarek Sherif
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+#include "../../shared/platform-interface.h"
+#include "../../shared/debug.h"
+#include "linux-watcher.h"
+
+#define WATCHED_DIRECTORY_COUNT 2
+#define MAX_PATH_LENGTH 256
+#define EVENT_BUFFER_SIZE 4096
+
+static const char* WATCHED_DIRECTORIES[WATCHED_DIRECTORY_COUNT] = {
+    "assets/shaders",
+    "assets/sprites"
+};
+
+static struct {
+    int32_t fd;
+    int32_t watches[WATCHED_DIRECTORY_COUNT];
+} watcher = {
+    .fd = -1
+};
+
+bool linux_initAssetWatcher(void) {
+    watcher.fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+    if (watcher.fd == -1) {
+        DEBUG_LOG("linux_initAssetWatcher: Failed to initialize inotify.");
+        goto ERROR_NO_RESOURCES;
+    }
+
+    //////////////////////////////////////////////////////
+    // Editors either write files in place or write a
+    // temporary file and rename it over the original, so
+    // watch for both.
+    //////////////////////////////////////////////////////
+
+    bool watching = false;
+    for (int32_t i = 0; i < WATCHED_DIRECTORY_COUNT; ++i) {
+        watcher.watches[i] = inotify_add_watch(watcher.fd, WATCHED_DIRECTORIES[i], IN_CLOSE_WRITE | IN_MOVED_TO);
+        watching = watching || watcher.watches[i] != -1;
+    }
+
+    if (!watching) {
+        DEBUG_LOG("linux_initAssetWatcher: No asset directories to watch.");
+        goto ERROR_INOTIFY;
+    }
+
+    return true;
+
+    ERROR_INOTIFY:
+    close(watcher.fd);
+    watcher.fd = -1;
+
+    ERROR_NO_RESOURCES:
+    return false;
+}
+
+void linux_updateAssetWatcher(void) {
+    if (watcher.fd == -1) {
+        return;
+    }
+
+    _Alignas(struct inotify_event) char buffer[EVENT_BUFFER_SIZE];
+    char path[MAX_PATH_LENGTH];
+
+    while (true) {
+        ssize_t length = read(watcher.fd, buffer, EVENT_BUFFER_SIZE);
+
+        // EAGAIN once there are no more events.
+        if (length <= 0) {
+            return;
+        }
+
+        for (char* next = buffer; next < buffer + length;) {
+            const struct inotify_event* event = (const struct inotify_event *) next;
+            next += sizeof(struct inotify_event) + event->len;
+
+            if (event->len == 0) {
+                continue;
+            }
+
+            for (int32_t i = 0; i < WATCHED_DIRECTORY_COUNT; ++i) {
+                if (event->wd == watcher.watches[i] && snprintf(path, MAX_PATH_LENGTH, "%s/%s", WATCHED_DIRECTORIES[i], event->name) < MAX_PATH_LENGTH) {
+                    game_reloadAsset(path);
+                }
+            }
+        }
+    }
+}
+
+void linux_closeAssetWatcher(void) {
+    if (watcher.fd == -1) {
+        return;
+    }
+
+    // Closing the descriptor removes its watches.
+    close(watcher.fd);
+    watcher.fd = -1;
+}
@@ -0,0 +1,42 @@
+////////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+// 
+// Copyright (c) 2021 Tarek Sherif
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _LINUX_WATCHER_H_
+#define _LINUX_WATCHER_H_
+
+//////////////////////////////////////////////////////////////////
+// Asset hot reloading for debug builds. Watches the shader and
+// sprite directories with inotify and passes changed files to
+// game_reloadAsset().
+//
+// - linux_initAssetWatcher(): Start watching asset directories.
+// - linux_updateAssetWatcher(): Reload any assets that changed
+//      since the last call. Call between frames.
+// - linux_closeAssetWatcher(): Stop watching.
+//////////////////////////////////////////////////////////////////
+
+bool linux_initAssetWatcher(void);
+void linux_updateAssetWatcher(void);
+void linux_closeAssetWatcher(void);
+
+#endif
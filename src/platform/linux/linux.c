@@ -30,39 +30,139 @@
 #define SOGL_IMPLEMENTATION_X11
 #include "../../../lib/simple-opengl-loader.h"
 #include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
 #include <X11/Xlib.h>
+#include <X11/XKBlib.h>
 #include <GL/glx.h>
-#include <time.h>
 #include <sys/stat.h>
 #include "../../shared/constants.h"
 #include "../../shared/platform-interface.h"
 #include "../../shared/debug.h"
+#include "../posix/posix.h"
 #include "linux-audio.h"
+#include "linux-jobs.h"
+#include "linux-watcher.h"
+#include "linux-startup.h"
+#include "linux-pacer.h"
+#include "linux-events.h"
 #include "linux-gamepad.h"
+#include "linux-simulation.h"
+#include "linux-latency.h"
+#include "linux-time.h"
 
 #define NET_WM_STATE_REMOVE 0
 #define NET_WM_STATE_ADD    1
 
 static Linux_Gamepad gamepad;
 
+// The simulation may run on its own thread, so the main
+// loop publishes a copy of the input state for
+// platform_getInput() to read.
+static struct {
+    pthread_mutex_t lock;
+    Linux_Gamepad gamepad;
+} sharedInput = { .lock = PTHREAD_MUTEX_INITIALIZER };
+
 typedef GLXContext (*glXCreateContextAttribsARBFUNC)(Display* display, GLXFBConfig framebufferConfig, GLXContext shareContext, Bool direct, const int32_t* contextAttribs);
-typedef void (*glXSwapIntervalEXTFUNC)(Display* display, GLXDrawable window, int32_t interval);
 
 int xErrorHandler(Display* display, XErrorEvent* event) {
     platform_userMessage("An Xlib error occurred.");
     return 0;
 }
 
-int64_t nsFromTimeSpec(struct timespec timeSpec) {
-    return timeSpec.tv_sec * SPACE_SHOOTER_SECOND + timeSpec.tv_nsec;
-}
-
 int32_t main(int32_t argc, char const *argv[]) {
     int32_t exitStatus = 1;
 
+    ////////////////////////////////////////////////////
+    // Command line options:
+    // - --startup-log: Print startup phase timings.
+    // - --exit-after-first-frame: Quit once the first
+    //      frame is presented.
+    // - --startup-benchmark N: Launch the game N times
+    //      and report cold and warm startup times.
+    // - --launch-time NS: Used by the benchmark to pass
+    //      the time it launched the process.
+    // - --simulation-thread: Run the simulation on its
+    //      own thread, decoupled from drawing.
+    // - --latency-log: Print input latency histograms
+    //      on exit.
+    // - --tick-rate HZ: Simulation ticks per second
+    //      (60 to 240).
+    // - --simulation-benchmark SECONDS: Simulate SECONDS
+    //      of game time at 60, 120 and 240 Hz and report
+    //      how the cost scales.
+    // - --simulation-benchmark-run SECONDS: Used by the
+    //      benchmark to run it at the current tick rate.
+    ////////////////////////////////////////////////////
+
+    bool startupLog = false;
+    bool latencyLog = false;
+    bool exitAfterFirstFrame = false;
+    bool simulationThread = false;
+    int32_t benchmarkRuns = 0;
+    int64_t launchTime = 0;
+    int32_t tickRate = 0;
+    float simulationBenchmarkTime = 0.0f;
+    float simulationBenchmarkRunTime = 0.0f;
+
+    for (int32_t i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--startup-log") == 0) {
+            startupLog = true;
+        } else if (strcmp(argv[i], "--exit-after-first-frame") == 0) {
+            exitAfterFirstFrame = true;
+        } else if (strcmp(argv[i], "--startup-benchmark") == 0 && i + 1 < argc) {
+            benchmarkRuns = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--launch-time") == 0 && i + 1 < argc) {
+            launchTime = strtoll(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--simulation-thread") == 0) {
+            simulationThread = true;
+        } else if (strcmp(argv[i], "--latency-log") == 0) {
+            latencyLog = true;
+        } else if (strcmp(argv[i], "--tick-rate") == 0 && i + 1 < argc) {
+            tickRate = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--simulation-benchmark") == 0 && i + 1 < argc) {
+            simulationBenchmarkTime = strtof(argv[++i], NULL);
+        } else if (strcmp(argv[i], "--simulation-benchmark-run") == 0 && i + 1 < argc) {
+            simulationBenchmarkRunTime = strtof(argv[++i], NULL);
+        }
+    }
+
+    if (benchmarkRuns > 0) {
+        return linux_runStartupBenchmark(benchmarkRuns);
+    }
+
+    if (simulationBenchmarkTime > 0.0f) {
+        return linux_runSimulationBenchmark(simulationBenchmarkTime);
+    }
+
+    // The benchmark drives game_simulate() itself,
+    // without audio so sounds aren't spammed.
+    bool simulationBenchmark = simulationBenchmarkRunTime > 0.0f;
+
+    if (simulationBenchmark) {
+        simulationThread = true;
+    }
+
+    linux_beginStartup(launchTime);
+
+    ////////////////////////////////////////////////////
+    // Prefer the packed archive, but fall back to loose
+    // files in the asset directory. Debug builds prefer
+    // loose files so they can be hot reloaded.
+    ////////////////////////////////////////////////////
+
+    platform_startupPhase("mount-assets");
+
     struct stat assetsStat = { 0 };
-    int statResult = stat("./assets", &assetsStat);
-    if (statResult == -1 || !S_ISDIR(assetsStat.st_mode)) {
+    bool looseAssets = stat("./assets", &assetsStat) == 0 && S_ISDIR(assetsStat.st_mode);
+    bool preferLooseAssets = false;
+
+#ifdef SPACE_SHOOTER_DEBUG
+    preferLooseAssets = looseAssets;
+#endif
+
+    if (!preferLooseAssets && !posix_mountArchive(SPACE_SHOOTER_ASSET_ARCHIVE) && !looseAssets) {
         platform_userMessage("Asset directory not found.\nDid you move the game executable without moving the assets?");
         goto EXIT_NO_RESOURCES;
     }
@@ -73,6 +173,8 @@ int32_t main(int32_t argc, char const *argv[]) {
     // Connect to X server
     /////////////////////////
 
+    platform_startupPhase("x-connection");
+
     Display* display = XOpenDisplay(NULL);
 
     if (display == NULL) {
@@ -88,6 +190,8 @@ int32_t main(int32_t argc, char const *argv[]) {
     // so we can create window with that configuration.
     //////////////////////////////////////////////////////
 
+    platform_startupPhase("choose-fb-config");
+
     int32_t fbcCount = 0;
     GLXFBConfig *fbcList = glXChooseFBConfig(display, DefaultScreen(display), (int32_t[]) {
         GLX_RENDER_TYPE, GLX_RGBA_BIT, 
@@ -138,6 +242,8 @@ int32_t main(int32_t argc, char const *argv[]) {
     // NOTE(Tarek): border pixel is required in case depth doesn't match parent depth.
     // See: https://tronche.com/gui/x/xlib/window/attributes/border.html
 
+    platform_startupPhase("create-window");
+
     Window rootWindow = XRootWindow(display, visualInfo->screen);
     Colormap colorMap = XCreateColormap(display, rootWindow, visualInfo->visual, AllocNone);
     Window window = XCreateWindow(
@@ -152,7 +258,7 @@ int32_t main(int32_t argc, char const *argv[]) {
         CWColormap | CWEventMask | CWBorderPixel,
         &(XSetWindowAttributes) {
             .colormap = colorMap,
-            .event_mask = ExposureMask | KeyPressMask | KeyReleaseMask,
+            .event_mask = ExposureMask | KeyPressMask | KeyReleaseMask | FocusChangeMask | VisibilityChangeMask | StructureNotifyMask,
             .border_pixel = 0
         }
     );
@@ -176,8 +282,9 @@ int32_t main(int32_t argc, char const *argv[]) {
     // Create OpenGL context
     ///////////////////////////
 
+    platform_startupPhase("create-context");
+
     glXCreateContextAttribsARBFUNC glXCreateContextAttribsARB = (glXCreateContextAttribsARBFUNC) glXGetProcAddress((const GLubyte *) "glXCreateContextAttribsARB");
-    glXSwapIntervalEXTFUNC glXSwapIntervalEXT = (glXSwapIntervalEXTFUNC) glXGetProcAddress((const GLubyte *) "glXSwapIntervalEXT");
 
     if (!glXCreateContextAttribsARB) {
         DEBUG_LOG("Failed to load GLX extension functions.");
@@ -199,10 +306,10 @@ int32_t main(int32_t argc, char const *argv[]) {
     }
 
     glXMakeCurrent(display, window, gl);
+    linux_initPacer(display, window);
+    linux_initLatency(display, window);
 
-    if (glXSwapIntervalEXT) {
-        glXSwapIntervalEXT(display, window, 1);
-    }
+    platform_startupPhase("load-opengl");
 
     if (!sogl_loadOpenGL()) {
 #ifdef SPACE_SHOOTER_DEBUG
@@ -221,12 +328,18 @@ int32_t main(int32_t argc, char const *argv[]) {
     // Set up window manager events
     /////////////////////////////////
 
+    platform_startupPhase("map-window");
+
     Atom NET_WM_STATE = XInternAtom(display, "_NET_WM_STATE", False);
     Atom NET_WM_STATE_FULLSCREEN = XInternAtom(display, "_NET_WM_STATE_FULLSCREEN", False);
     Atom WM_DELETE_WINDOW = XInternAtom(display, "WM_DELETE_WINDOW", False);
 
     XSetWMProtocols(display, window, &WM_DELETE_WINDOW, 1);
 
+    // Held keys only repeat KeyPress, rather than sending a
+    // KeyRelease/KeyPress pair for each repeat.
+    XkbSetDetectableAutoRepeat(display, True, NULL);
+
     XEvent fullscreenEvent = {
         .xclient = {
             .type = ClientMessage,
@@ -277,20 +390,50 @@ int32_t main(int32_t argc, char const *argv[]) {
     // Initialize audio
     /////////////////////
 
-    if (!linux_initAudio()) {
+    platform_startupPhase("init-audio");
+
+    if (!simulationBenchmark && !linux_initAudio()) {
         platform_userMessage("Failed to initialize audio.");
     }
 
+    platform_startupPhase("init-jobs");
+
+    // Without workers, the game runs jobs itself.
+    if (!linux_initJobs()) {
+        DEBUG_LOG("Failed to start worker threads.");
+    }
+
     /////////////////////
     // Start game
     /////////////////////
 
-    linux_detectGamepad(); 
+    platform_startupPhase("init-gamepad");
 
-    if (!game_init(NULL)) {
+    linux_initGamepad();
+
+    platform_startupPhase("game-init");
+
+    if (!game_init(&(Game_InitOptions) {
+        .simulationThread = simulationThread,
+        .noAudio = simulationBenchmark,
+        .tickRate = tickRate
+    })) {
+        goto EXIT_GAME;
+    }
+
+    if (simulationBenchmark) {
+        exitStatus = linux_benchmarkSimulation(simulationBenchmarkRunTime, tickRate);
         goto EXIT_GAME;
     }
 
+    // If the thread can't be started, the main loop
+    // runs the simulation itself.
+    bool simulateOnMainThread = simulationThread && !linux_startSimulation();
+
+#ifdef SPACE_SHOOTER_DEBUG
+    linux_initAssetWatcher();
+#endif
+
     struct {
         bool left;
         bool right;
@@ -305,62 +448,156 @@ int32_t main(int32_t argc, char const *argv[]) {
     } systemInput = { 0 };
     XEvent event = { 0 };
     XWindowAttributes xWinAtt = { 0 };
+
+    if (!linux_initEvents(display)) {
+        DEBUG_LOG("Failed to set up waiting for events.");
+    }
     
-    struct timespec timeSpec = { 0 };
-    clock_gettime(CLOCK_MONOTONIC, &timeSpec);
-    int64_t lastTime = nsFromTimeSpec(timeSpec);
-    int64_t gamePadPollTime = 0;
+    int64_t lastTime = linux_currentTime();
     
     bool fullscreen = true;
     bool running = true;
+    bool firstFrame = true;
+
+    ///////////////////////////////////////////////////////
+    // While the window is unfocused, minimized (unmapped)
+    // or fully covered, the game is in the background: the
+    // simulation is paused and the loop only wakes up a few
+    // times a second to handle events. Frames are only
+    // drawn if part of the window needs to be repainted.
+    // Everything starts out true, so a window manager that
+    // never sends these events can't leave the game stuck
+    // in the background.
+    ///////////////////////////////////////////////////////
+
+    bool focused = true;
+    bool mapped = true;
+    bool obscured = false;
+    bool background = false;
+
+    platform_startupPhase("first-frame");
 
     while (running) {
-        while (XCheckTypedWindowEvent(display, window, ClientMessage, &event) == True) {
-            if (event.xclient.data.l[0] == WM_DELETE_WINDOW) {
-                running = false;
-            }
-        }
-
-        while (XCheckTypedWindowEvent(display, window, Expose, &event) == True) {
-            XGetWindowAttributes(display, window, &xWinAtt);
-            game_resize(xWinAtt.width, xWinAtt.height);
-        }
-
-        while (XCheckWindowEvent(display, window, KeyPressMask | KeyReleaseMask, &event) == True) {
-            bool down = event.type == KeyPress;
-
-            KeySym key = XLookupKeysym(&event.xkey, 0);
-
-            switch (key) {
-                case XK_Left: keyboardDirections.left = down; break;
-                case XK_Right: keyboardDirections.right = down; break;
-                case XK_Down: keyboardDirections.down = down; break;
-                case XK_Up: keyboardDirections.up = down; break;
-                case XK_space: gamepad.aButton = down; break;
-                case XK_Escape: gamepad.backButton = down; break;
-                case XK_f: gamepad.startButton = down; break;
+        ///////////////////////////////////////////////////////
+        // Sleep until the frame deadline, handling input as
+        // it arrives, so it's as fresh as possible when the
+        // frame is drawn. Events are drained in a single pass
+        // before each wait, since Xlib may already have read
+        // them off the connection.
+        ///////////////////////////////////////////////////////
+
+        bool wasBackground = background;
+        int64_t deadline = linux_frameDeadline(background);
+        bool exposed = false;
+
+        do {
+            while (XPending(display)) {
+                XNextEvent(display, &event);
+
+                switch (event.type) {
+                    case ClientMessage: {
+                        if ((Atom) event.xclient.data.l[0] == WM_DELETE_WINDOW) {
+                            running = false;
+                        }
+                    } break;
+                    case Expose: {
+                        exposed = true;
+                    } break;
+                    // Grabs (e.g. window manager shortcuts) move focus
+                    // temporarily, so they're ignored.
+                    case FocusIn:
+                    case FocusOut: {
+                        if (event.xfocus.mode != NotifyGrab && event.xfocus.mode != NotifyUngrab) {
+                            focused = event.type == FocusIn;
+                        }
+                    } break;
+                    case MapNotify: {
+                        mapped = true;
+                    } break;
+                    case UnmapNotify: {
+                        mapped = false;
+                    } break;
+                    case VisibilityNotify: {
+                        obscured = event.xvisibility.state == VisibilityFullyObscured;
+                    } break;
+                    case KeyPress:
+                    case KeyRelease: {
+                        bool down = event.type == KeyPress;
+                        bool* keyState = NULL;
+
+                        KeySym key = XLookupKeysym(&event.xkey, 0);
+
+                        switch (key) {
+                            case XK_Left: keyState = &keyboardDirections.left; break;
+                            case XK_Right: keyState = &keyboardDirections.right; break;
+                            case XK_Down: keyState = &keyboardDirections.down; break;
+                            case XK_Up: keyState = &keyboardDirections.up; break;
+                            case XK_space: keyState = &gamepad.aButton; break;
+                            case XK_Escape: keyState = &gamepad.backButton; break;
+                            case XK_f: keyState = &gamepad.startButton; break;
+                        }
+
+                        // Skip autorepeats of held keys.
+                        if (!keyState || *keyState == down) {
+                            break;
+                        }
+
+                        *keyState = down;
+
+                        // Event times are in milliseconds on the X server's
+                        // clock, so keys are stamped as they're read.
+                        int64_t keyTime = linux_currentTime();
+
+                        if (!gamepad.time) {
+                            gamepad.time = keyTime;
+                        }
+
+                        if (key == XK_space) {
+                            linux_addShootEvent(&gamepad, &(Game_InputEvent) {
+                                .time = keyTime,
+                                .shoot = down
+                            });
+                        }
+
+                        if (keyboardDirections.left) {
+                            gamepad.stickX = -1.0f;
+                        } else if (keyboardDirections.right) {
+                            gamepad.stickX = 1.0f;
+                        } else {
+                            gamepad.stickX = 0.0f;
+                        }
+
+                        if (keyboardDirections.down) {
+                            gamepad.stickY = -1.0f;
+                        } else if (keyboardDirections.up) {
+                            gamepad.stickY = 1.0f;
+                        } else {
+                            gamepad.stickY = 0.0f;
+                        }
+
+                        gamepad.keyboard = true;
+                    } break;
+                    default: {
+                        linux_handleLatencyEvent(&event);
+                    } break;
+                }
             }
 
-            if (keyboardDirections.left) {
-                gamepad.stickX = -1.0f;
-            } else if (keyboardDirections.right) {
-                gamepad.stickX = 1.0f;
-            } else {
-                gamepad.stickX = 0.0f;
-            }
+            background = !focused || !mapped || obscured;
+        } while (background == wasBackground && linux_waitForEvents(deadline));
 
-            if (keyboardDirections.down) {
-                gamepad.stickY = -1.0f;
-            } else if (keyboardDirections.up) {
-                gamepad.stickY = 1.0f;
-            } else {
-                gamepad.stickY = 0.0f;
-            }
+        int64_t time = linux_beginFrame();
+        linux_updateGamepad(&gamepad);
+        int64_t elapsedTime = time - lastTime;
 
-            gamepad.keyboard = true;
+        if (background != wasBackground) {
+            linux_pauseSimulation(background);
         }
 
-        linux_updateGamepad(&gamepad);
+        if (exposed) {
+            XGetWindowAttributes(display, window, &xWinAtt);
+            game_resize(xWinAtt.width, xWinAtt.height);
+        }
         
         systemInput.toggleFullscreen = gamepad.startButton;
         if (systemInput.toggleFullscreen && !systemInput.lastToggleFullscreen) {
@@ -379,38 +616,80 @@ int32_t main(int32_t argc, char const *argv[]) {
         }
         systemInput.lastQuit = systemInput.quit;
 
-        clock_gettime(CLOCK_MONOTONIC, &timeSpec);
-        int64_t time = nsFromTimeSpec(timeSpec);
-        int64_t elapsedTime = time - lastTime;
-
-        // Sleep if at least 1ms less than frame min
-        if (SPACE_SHOOTER_MIN_FRAME_TIME - elapsedTime > SPACE_SHOOTER_MILLISECOND) {
-            struct timespec sleepTime = {
-                .tv_nsec = SPACE_SHOOTER_MIN_FRAME_TIME - elapsedTime
-            };
-            nanosleep(&sleepTime, NULL);
+        // Keep the oldest change and the shoot events the
+        // simulation hasn't seen yet.
+        pthread_mutex_lock(&sharedInput.lock);
+        Linux_Gamepad unread = sharedInput.gamepad;
+        sharedInput.gamepad = gamepad;
+        sharedInput.gamepad.time = unread.time ? unread.time : gamepad.time;
+        sharedInput.gamepad.shootEventCount = 0;
 
-            clock_gettime(CLOCK_MONOTONIC, &timeSpec);
-            time = nsFromTimeSpec(timeSpec);
-            elapsedTime = time - lastTime;
+        for (int32_t i = 0; i < unread.shootEventCount; ++i) {
+            linux_addShootEvent(&sharedInput.gamepad, unread.shootEvents + i);
         }
 
-        gamePadPollTime += elapsedTime;
-        if (gamePadPollTime > SPACE_SHOOTER_GAMEPAD_POLL_TIME) {
-            linux_detectGamepad();
-            gamePadPollTime = 0;
+        for (int32_t i = 0; i < gamepad.shootEventCount; ++i) {
+            linux_addShootEvent(&sharedInput.gamepad, gamepad.shootEvents + i);
         }
 
-        game_update((float) elapsedTime / SPACE_SHOOTER_MILLISECOND);
-        game_draw();
+        pthread_mutex_unlock(&sharedInput.lock);
+        gamepad.time = 0;
+        gamepad.shootEventCount = 0;
 
-        glXSwapBuffers(display, window);
+#ifdef SPACE_SHOOTER_DEBUG
+        linux_updateAssetWatcher();
+#endif
 
         lastTime = time;
+
+        // game_resize() above already drew the frame, so it
+        // just needs to be presented.
+        if (background || wasBackground) {
+            if (exposed) {
+                linux_presentFrame();
+                linux_framePresented(game_drawnInputTime());
+            }
+        } else {
+            platform_startupPhase("first-update");
+            if (simulateOnMainThread) {
+                game_simulate((float) elapsedTime / SPACE_SHOOTER_MILLISECOND);
+            }
+            game_update((float) elapsedTime / SPACE_SHOOTER_MILLISECOND);
+
+            platform_startupPhase("first-draw");
+            game_draw();
+
+            platform_startupPhase("first-swap");
+            linux_presentFrame();
+            linux_framePresented(game_drawnInputTime());
+        }
+
+        // Startup also ends if the window starts out in the
+        // background, so --exit-after-first-frame can't hang.
+        if (firstFrame) {
+            // Wait for the swap so the time includes
+            // getting the frame on screen.
+            glFinish();
+            linux_endStartup(startupLog);
+            firstFrame = false;
+            running = running && !exitAfterFirstFrame;
+        }
     };
 
+    if (latencyLog) {
+        linux_reportLatency();
+    }
+
+    exitStatus = 0;
+
     EXIT_GAME:
+    linux_stopSimulation(); // First, since the simulation uses everything below.
+    linux_closeEvents();
+#ifdef SPACE_SHOOTER_DEBUG
+    linux_closeAssetWatcher();
+#endif
     linux_closeGamepad();
+    linux_closeJobs(); // Before closeAudio since jobs may be loading sounds.
     linux_closeAudio();
     game_close(); // NOTE(Tarek): After closeAudio so audio buffers don't get freed while playing.
 
@@ -427,17 +706,30 @@ int32_t main(int32_t argc, char const *argv[]) {
 
     EXIT_ERROR_HANDLER:
     XSetErrorHandler(NULL);
+    posix_unmapFiles();
     
     EXIT_NO_RESOURCES:
     return exitStatus;
 }
 
 void platform_getInput(Game_Input* input) {
+    pthread_mutex_lock(&sharedInput.lock);
+
     input->lastShoot = input->shoot;
-    input->velocity[0] = gamepad.stickX;
-    input->velocity[1] = gamepad.stickY;
-    input->shoot = gamepad.aButton;
-    input->keyboard = gamepad.keyboard;
+    input->velocity[0] = sharedInput.gamepad.stickX;
+    input->velocity[1] = sharedInput.gamepad.stickY;
+    input->shoot = sharedInput.gamepad.aButton;
+    input->keyboard = sharedInput.gamepad.keyboard;
+    input->time = sharedInput.gamepad.time;
+    sharedInput.gamepad.time = 0;
+
+    input->eventCount = sharedInput.gamepad.shootEventCount;
+    memcpy(input->events, sharedInput.gamepad.shootEvents, input->eventCount * sizeof(Game_InputEvent));
+    sharedInput.gamepad.shootEventCount = 0;
+
+    input->sampleTime = linux_currentTime();
+
+    pthread_mutex_unlock(&sharedInput.lock);
 }
 
 void platform_userMessage(const char* message) {
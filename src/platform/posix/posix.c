@@ -1,9 +1,31 @@
 #include <unistd.h>
 #include <fcntl.h>
 #include <malloc.h>
+#include <string.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "../../shared/platform-interface.h"
 #include "../../shared/data.h"
 #include "../../shared/debug.h"
+#include "../../shared/archive.h"
+#include "posix.h"
+
+#define MAX_MAPPED_FILES 32
+
+static Data_Buffer archive;
+
+// Loose files mapped by platform_mapFile(), held until
+// platform_unmapFile() or posix_unmapFiles().
+// Assets may be loaded from worker threads, so the
+// pool of mappings is guarded by a lock.
+static struct {
+    Data_Buffer files[MAX_MAPPED_FILES];
+    int32_t count;
+    pthread_mutex_t lock;
+} mappedFiles = {
+    .lock = PTHREAD_MUTEX_INITIALIZER
+};
 
 void platform_debugMessage(const char* message) {
     int32_t length = 0;
@@ -15,7 +37,190 @@ void platform_debugMessage(const char* message) {
     write(STDERR_FILENO, "\n", 1);
 }
 
+bool posix_mountArchive(const char* fileName) {
+    int32_t fd = open(fileName, O_RDONLY);
+
+    if (fd == -1) {
+        DEBUG_LOG("posix_mountArchive: Failed to open archive.");
+        goto ERROR_NO_RESOURCES;
+    }
+
+    struct stat archiveStat = { 0 };
+    if (fstat(fd, &archiveStat) == -1 || archiveStat.st_size == 0) {
+        DEBUG_LOG("posix_mountArchive: Failed to get archive size.");
+        goto ERROR_FILE_OPENED;
+    }
+
+    ///////////////////////////////////////////////////////
+    // The whole archive is mapped at once, so loading an
+    // asset is just an index lookup into the mapping.
+    ///////////////////////////////////////////////////////
+
+    void* data = mmap(NULL, archiveStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    if (data == MAP_FAILED) {
+        DEBUG_LOG("posix_mountArchive: Failed to map archive.");
+        goto ERROR_FILE_OPENED;
+    }
+
+    archive.data = (uint8_t *) data;
+    archive.size = archiveStat.st_size;
+
+    if (!archive_validate(&archive)) {
+        DEBUG_LOG("posix_mountArchive: Invalid archive.");
+        goto ERROR_MAPPED;
+    }
+
+    // Mapping stays valid after the file is closed.
+    close(fd);
+
+    return true;
+
+    ERROR_MAPPED:
+    munmap(archive.data, archive.size);
+    archive.data = NULL;
+    archive.size = 0;
+
+    ERROR_FILE_OPENED:
+    close(fd);
+
+    ERROR_NO_RESOURCES:
+    return false;
+}
+
+void posix_unmapFiles(void) {
+    for (int32_t i = 0; i < mappedFiles.count; ++i) {
+        munmap(mappedFiles.files[i].data, mappedFiles.files[i].size);
+    }
+    mappedFiles.count = 0;
+
+    if (!archive.data) {
+        return;
+    }
+
+    munmap(archive.data, archive.size);
+    archive.data = NULL;
+    archive.size = 0;
+}
+
+void platform_unmapFile(const uint8_t* data) {
+    pthread_mutex_lock(&mappedFiles.lock);
+
+    for (int32_t i = 0; i < mappedFiles.count; ++i) {
+        Data_Buffer* file = mappedFiles.files + i;
+
+        if (data >= file->data && data < file->data + file->size) {
+            munmap(file->data, file->size);
+            *file = mappedFiles.files[mappedFiles.count - 1];
+            --mappedFiles.count;
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&mappedFiles.lock);
+}
+
+static bool loadArchiveFile(const char* fileName, Data_Buffer* buffer, bool nullTerminate) {
+    Data_Buffer contents = { 0 };
+
+    if (!archive_find(&archive, fileName, &contents)) {
+        return false;
+    }
+
+    uint32_t allocation = contents.size;
+
+    if (nullTerminate) {
+        allocation += 1;
+    }
+
+    uint8_t* data = (uint8_t*) malloc(allocation);
+
+    if (!data) {
+        DEBUG_LOG("platform_loadFile: Failed to allocate data.");
+        return false;
+    }
+
+    memcpy(data, contents.data, contents.size);
+
+    if (nullTerminate) {
+        data[allocation - 1] = 0;
+    }
+
+    buffer->data = data;
+    buffer->size = allocation;
+
+    return true;
+}
+
+bool platform_mapFile(const char* fileName, Data_Buffer* buffer) {
+    if (archive.data && archive_find(&archive, fileName, buffer)) {
+        buffer->view = true;
+        return true;
+    }
+
+    int32_t fd = open(fileName, O_RDONLY);
+
+    if (fd == -1) {
+        DEBUG_LOG("platform_mapFile: Failed to open file.");
+        goto ERROR_NO_RESOURCES;
+    }
+
+    struct stat fileStat = { 0 };
+    if (fstat(fd, &fileStat) == -1) {
+        DEBUG_LOG("platform_mapFile: Failed to get file size.");
+        goto ERROR_FILE_OPENED;
+    }
+
+    // Empty files can't be mapped.
+    if (fileStat.st_size == 0) {
+        close(fd);
+        return platform_loadFile(fileName, buffer, false);
+    }
+
+    void* data = mmap(NULL, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    if (data == MAP_FAILED) {
+        DEBUG_LOG("platform_mapFile: Failed to map file.");
+        goto ERROR_FILE_OPENED;
+    }
+
+    close(fd);
+
+    pthread_mutex_lock(&mappedFiles.lock);
+
+    bool recorded = mappedFiles.count < MAX_MAPPED_FILES;
+    if (recorded) {
+        mappedFiles.files[mappedFiles.count].data = (uint8_t *) data;
+        mappedFiles.files[mappedFiles.count].size = fileStat.st_size;
+        ++mappedFiles.count;
+    }
+
+    pthread_mutex_unlock(&mappedFiles.lock);
+
+    if (!recorded) {
+        DEBUG_LOG("platform_mapFile: Too many mapped files. Loading instead.");
+        munmap(data, fileStat.st_size);
+        return platform_loadFile(fileName, buffer, false);
+    }
+
+    buffer->data = (uint8_t *) data;
+    buffer->size = fileStat.st_size;
+    buffer->view = true;
+
+    return true;
+
+    ERROR_FILE_OPENED:
+    close(fd);
+
+    ERROR_NO_RESOURCES:
+    return false;
+}
+
 bool platform_loadFile(const char* fileName, Data_Buffer* buffer, bool nullTerminate) {
+    if (archive.data && loadArchiveFile(fileName, buffer, nullTerminate)) {
+        return true;
+    }
+
     int32_t fd = open(fileName, O_RDONLY);
     uint8_t* data = 0;
 
@@ -0,0 +1,45 @@
+////////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+// 
+// Copyright (c) 2021 Tarek Sherif
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _POSIX_H_
+#define _POSIX_H_
+
+#include <stdbool.h>
+
+//////////////////////////////////////////////////////////////////
+// File mapping functions shared by POSIX platforms.
+//
+// - posix_mountArchive(): Map a packed asset archive (see
+//      archive.h) into memory. While mounted, platform_loadFile()
+//      and platform_mapFile() serve files from the archive,
+//      falling back to loose files for anything not in it.
+// - posix_unmapFiles(): Release the archive and any loose files
+//      mapped by platform_mapFile() that haven't been released
+//      with platform_unmapFile(). Views into them must no longer
+//      be in use.
+//////////////////////////////////////////////////////////////////
+
+bool posix_mountArchive(const char* fileName);
+void posix_unmapFiles(void);
+
+#endif
@@ -16,7 +16,6 @@ typedef struct {
 } AudioStream;
 
 static struct {
-    Data_Buffer data[SPACE_SHOOTER_AUDIO_MAX_SOUNDS];
     ALuint buffers[SPACE_SHOOTER_AUDIO_MAX_SOUNDS];
     int32_t count;
 } sounds;
@@ -86,12 +85,13 @@ void web_updateAudio(void) {
     }
 }
 
-int32_t platform_loadSound(const char* fileName) {
+int32_t platform_loadSound(const char* fileName, Game_SoundOptions* opts) {
     DEBUG_ASSERT(sounds.count < SPACE_SHOOTER_AUDIO_MAX_SOUNDS, "Attempting to load too many sounds.");
 
     int32_t id = sounds.count;
+    Data_Buffer pcm = { 0 };
     
-    if (!utils_loadWavData(fileName, sounds.data + id)) {
+    if (!utils_loadWavData(fileName, &pcm, SPACE_SHOOTER_AUDIO_SAMPLE_RATE)) {
         goto ERROR_NO_RESOURCES;
     }
 
@@ -99,15 +99,22 @@ int32_t platform_loadSound(const char* fileName) {
     alGenBuffers(1, sounds.buffers + id);
 
     if (alGetError() != AL_NO_ERROR) {
-        goto ERROR_NO_RESOURCES;
+        goto ERROR_PCM;
     }
 
-    alBufferData(sounds.buffers[id], AL_FORMAT_STEREO16, sounds.data[id].data, sounds.data[id].size, SPACE_SHOOTER_AUDIO_SAMPLE_RATE);
+    ///////////////////////////////////////////////////////
+    // OpenAL keeps its own copy of the audio outside the
+    // wasm heap, so the PCM data can be released as soon
+    // as it's been buffered.
+    ///////////////////////////////////////////////////////
+
+    alBufferData(sounds.buffers[id], AL_FORMAT_STEREO16, pcm.data, pcm.size, SPACE_SHOOTER_AUDIO_SAMPLE_RATE);
 
     if (alGetError() != AL_NO_ERROR) {
         goto ERROR_BUFFER;
     }
 
+    data_freeBuffer(&pcm);
     ++sounds.count;
 
     return id;
@@ -115,27 +122,44 @@ int32_t platform_loadSound(const char* fileName) {
     ERROR_BUFFER:
     alDeleteBuffers(1, sounds.buffers + id);
 
+    ERROR_PCM:
+    data_freeBuffer(&pcm);
+
     ERROR_NO_RESOURCES:
     return -1;
 }
 
-void platform_playSound(int32_t id, bool loop) {
+void platform_playSound(int32_t id, Game_PlaySoundOptions* opts) {
     if (!audio.device || id < 0) {
         return;
     }
 
     DEBUG_ASSERT(id < sounds.count, "Invalid sound ID.");
 
+    Game_PlaySoundOptions defaultOpts = { 0 };
+    if (!opts) {
+        opts = &defaultOpts;
+    }
+
     ALuint buffer = sounds.buffers[id];
 
     for (int32_t i = 0; i < SPACE_SHOOTER_AUDIO_MIXER_CHANNELS; ++i) {
         if (!audio.channels[i].inUse) {
             AudioStream* channel = audio.channels + i; 
             alSourcei(channel->source, AL_BUFFER, buffer);
-            alSourcei(channel->source, AL_LOOPING, loop ? AL_TRUE : AL_FALSE); 
+            alSourcei(channel->source, AL_LOOPING, opts->loop ? AL_TRUE : AL_FALSE);
+            // OpenAL only spatializes mono buffers, so pan is ignored here.
+            alSourcef(channel->source, AL_GAIN, 1.0f - opts->attenuation);
             alSourcePlay(channel->source);
             channel->inUse = true;
             break;
         }
     }
 }
+
+bool platform_getAudioStats(Game_AudioStats* stats) {
+    // Mixing is done by OpenAL, so there's nothing to report.
+    *stats = (Game_AudioStats) { 0 };
+
+    return false;
+}
@@ -77,4 +77,18 @@ int32_t main() {
 
 EM_JS(void, platform_userMessage, (const char* message), {
     alert(UTF8ToString(message));
-})
\ No newline at end of file
+})
+
+// No worker threads here, so the game runs jobs itself.
+int32_t platform_addJob(void (*function)(void* data), void* data) {
+    return -1;
+}
+
+bool platform_jobComplete(int32_t id) {
+    return true;
+}
+
+void platform_waitForJob(int32_t id) { }
+
+// Startup timing is only reported on Linux.
+void platform_startupPhase(const char* name) { }
\ No newline at end of file
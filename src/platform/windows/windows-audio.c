@@ -30,6 +30,7 @@
 #include <windows.h>
 #include <xaudio2.h>
 #include <stdbool.h>
+#include <math.h>
 #include "../../shared/constants.h"
 #include "../../shared/utils.h"
 #include "../../shared/debug.h"
@@ -47,6 +48,9 @@ static WAVEFORMATEX AUDIO_SOURCE_FORMAT = {
     .cbSize = 0
 };
 
+#define PI_OVER_4 0.78539816f
+#define SQRT_2 1.41421356f
+
 typedef struct {
     IXAudio2SourceVoice* voice;
     XAUDIO2_BUFFER buffer;
@@ -155,12 +159,12 @@ bool windows_initAudio(void) {
     return false;
 }
 
-int32_t platform_loadSound(const char* fileName) {
+int32_t platform_loadSound(const char* fileName, Game_SoundOptions* opts) {
     DEBUG_ASSERT(sounds.count < SPACE_SHOOTER_AUDIO_MAX_SOUNDS, "Attempting to load too many sounds.");
 
     int32_t id = sounds.count;
     
-    if (!utils_loadWavData(fileName, sounds.data + id)) {
+    if (!utils_loadWavData(fileName, sounds.data + id, SPACE_SHOOTER_AUDIO_SAMPLE_RATE)) {
         return -1;
     }
 
@@ -169,17 +173,37 @@ int32_t platform_loadSound(const char* fileName) {
     return id;
 }
 
-void platform_playSound(int32_t id, bool loop) {
+void platform_playSound(int32_t id, Game_PlaySoundOptions* opts) {
     if (!audio.xaudio || id < 0) {
         return;
     }
 
     DEBUG_ASSERT(id < sounds.count, "Invalid sound ID.");
 
+    Game_PlaySoundOptions defaultOpts = { 0 };
+    if (!opts) {
+        opts = &defaultOpts;
+    }
+
+    //////////////////////////////////////////////////////
+    // Constant-power pan, applied through the output
+    // matrix (rows are destination channels, columns
+    // source channels).
+    //////////////////////////////////////////////////////
+
+    float panAngle = (opts->pan + 1.0f) * PI_OVER_4;
+    float outputMatrix[4] = {
+        cosf(panAngle) * SQRT_2, 0.0f,
+        0.0f,                    sinf(panAngle) * SQRT_2
+    };
+
     for (int32_t i = 0; i < SPACE_SHOOTER_AUDIO_MIXER_CHANNELS; ++i) {
         if (!audio.channels[i].inUse) {
+            IXAudio2SourceVoice_SetVolume(audio.channels[i].voice, 1.0f - opts->attenuation, XAUDIO2_COMMIT_NOW);
+            IXAudio2SourceVoice_SetOutputMatrix(audio.channels[i].voice, NULL, SPACE_SHOOTER_AUDIO_CHANNELS, SPACE_SHOOTER_AUDIO_CHANNELS, outputMatrix, XAUDIO2_COMMIT_NOW);
+
             XAUDIO2_BUFFER* buffer = &audio.channels[i].buffer;
-            buffer->LoopCount = loop ? XAUDIO2_LOOP_INFINITE : 0;
+            buffer->LoopCount = opts->loop ? XAUDIO2_LOOP_INFINITE : 0;
             buffer->AudioBytes = sounds.data[id].size;
             buffer->pAudioData = sounds.data[id].data;
             IXAudio2SourceVoice_Start(audio.channels[i].voice, 0, XAUDIO2_COMMIT_NOW);
@@ -190,6 +214,13 @@ void platform_playSound(int32_t id, bool loop) {
     }
 }
 
+bool platform_getAudioStats(Game_AudioStats* stats) {
+    // Mixing is done by XAudio2, so there's nothing to report.
+    *stats = (Game_AudioStats) { 0 };
+
+    return false;
+}
+
 void windows_closeAudio(void) {
     if (!audio.xaudio) {
         return;
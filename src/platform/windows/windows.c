@@ -509,3 +509,24 @@ bool platform_loadFile(const char* fileName, Data_Buffer* buffer, bool nullTermi
     return false;
 }
 
+bool platform_mapFile(const char* fileName, Data_Buffer* buffer) {
+    // Files aren't mapped on Windows, so this returns a copy.
+    return platform_loadFile(fileName, buffer, false);
+}
+
+// Nothing to release, since platform_mapFile() never returns views.
+void platform_unmapFile(const uint8_t* data) { }
+
+// No worker threads here, so the game runs jobs itself.
+int32_t platform_addJob(void (*function)(void* data), void* data) {
+    return -1;
+}
+
+bool platform_jobComplete(int32_t id) {
+    return true;
+}
+
+void platform_waitForJob(int32_t id) { }
+
+// Startup timing is only reported on Linux.
+void platform_startupPhase(const char* name) { }
@@ -0,0 +1,115 @@
+////////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+// 
+// Copyright (c) 2021 Tarek Sherif
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+#include "archive.h"
+
+#define FNV_OFFSET_BASIS 2166136261u
+#define FNV_PRIME 16777619u
+
+uint32_t archive_hash(const char* name) {
+    uint32_t hash = FNV_OFFSET_BASIS;
+
+    for (const char* c = name; *c; ++c) {
+        hash ^= (uint8_t) *c;
+        hash *= FNV_PRIME;
+    }
+
+    return hash;
+}
+
+bool archive_validate(const Data_Buffer* archive) {
+    if (archive->size < sizeof(Archive_Header)) {
+        return false;
+    }
+
+    Archive_Header* header = (Archive_Header *) archive->data;
+
+    if (header->magic != ARCHIVE_MAGIC || header->version != ARCHIVE_VERSION || header->size != archive->size) {
+        return false;
+    }
+
+    uint64_t indexEnd = sizeof(Archive_Header) + (uint64_t) header->count * sizeof(Archive_Entry);
+    if (indexEnd > archive->size) {
+        return false;
+    }
+
+    Archive_Entry* entries = (Archive_Entry *) (header + 1);
+
+    for (uint32_t i = 0; i < header->count; ++i) {
+        Archive_Entry* entry = entries + i;
+
+        if (entry->offset < indexEnd || (uint64_t) entry->offset + entry->size > archive->size) {
+            return false;
+        }
+
+        if (entry->nameOffset < indexEnd || (uint64_t) entry->nameOffset + entry->nameLength > archive->size) {
+            return false;
+        }
+
+        if (entry->alignment == 0 || entry->offset % entry->alignment != 0) {
+            return false;
+        }
+
+        // Binary search in archive_find relies on unique, sorted hashes.
+        if (i > 0 && entries[i - 1].hash >= entry->hash) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool archive_find(const Data_Buffer* archive, const char* name, Data_Buffer* contents) {
+    Archive_Header* header = (Archive_Header *) archive->data;
+    Archive_Entry* entries = (Archive_Entry *) (header + 1);
+    uint32_t hash = archive_hash(name);
+
+    uint32_t low = 0;
+    uint32_t high = header->count;
+
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+
+        if (entries[mid].hash < hash) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    if (low == header->count || entries[low].hash != hash) {
+        return false;
+    }
+
+    // Another path could share the hash, so confirm the name.
+    Archive_Entry* entry = entries + low;
+    if (strlen(name) != entry->nameLength || memcmp(archive->data + entry->nameOffset, name, entry->nameLength) != 0) {
+        return false;
+    }
+
+    contents->data = archive->data + entry->offset;
+    contents->size = entry->size;
+
+    return true;
+}
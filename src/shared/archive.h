@@ -0,0 +1,74 @@
+////////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+// 
+// Copyright (c) 2021 Tarek Sherif
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _ARCHIVE_H_
+#define _ARCHIVE_H_
+#include <stdint.h>
+#include <stdbool.h>
+#include "data.h"
+
+//////////////////////////////////////////////////////////////////////
+// Packed asset archive. The file starts with an Archive_Header,
+// followed by `count` Archive_Entry records sorted by the hash
+// of the asset's path (e.g. "assets/sprites/ship.bmp"). The
+// paths themselves follow the index, so lookups can confirm a
+// hash match. Asset contents follow the paths, each starting at
+// an offset that's a multiple of its alignment, with the gaps
+// zero-filled. All values are little-endian.
+//////////////////////////////////////////////////////////////////////
+
+#define ARCHIVE_MAGIC 0x4b415053 // "SPAK" little-endian
+#define ARCHIVE_VERSION 2
+#define ARCHIVE_ALIGNMENT 16
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t count;
+    uint32_t size;
+} Archive_Header;
+
+typedef struct {
+    uint32_t hash;
+    uint32_t nameOffset;
+    uint32_t nameLength;
+    uint32_t offset;
+    uint32_t size;
+    uint32_t alignment;
+} Archive_Entry;
+
+//////////////////////////////////////////////////////////////////////////////
+// Archive functions.
+//
+// - archive_hash(): 32-bit FNV-1a hash of an asset path.
+// - archive_validate(): Check that the header, index and every entry
+//      and path fit within the archive data.
+// - archive_find(): Find an asset by path. On success, `contents`
+//      points into the archive data and must not be freed.
+//////////////////////////////////////////////////////////////////////////////
+
+uint32_t archive_hash(const char* name);
+bool archive_validate(const Data_Buffer* archive);
+bool archive_find(const Data_Buffer* archive, const char* name, Data_Buffer* contents);
+
+#endif
@@ -0,0 +1,328 @@
+////////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+// 
+// Copyright (c) 2021 Tarek Sherif
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "debug.h"
+#include "audio.h"
+
+////////////////////////////////////////////////////////////////////
+// Tables from the IMA ADPCM reference:
+// - https://wiki.multimedia.cx/index.php/IMA_ADPCM
+////////////////////////////////////////////////////////////////////
+
+#define ADPCM_MAX_STEP_INDEX 88
+
+#define RESAMPLER_PI 3.14159265f
+#define RESAMPLER_CUTOFF 0.9f // Fraction of the lower Nyquist frequency to pass
+
+static const int16_t ADPCM_STEPS[ADPCM_MAX_STEP_INDEX + 1] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230,
+    253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+    1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+    3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487,
+    12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+
+static const int8_t ADPCM_INDEX_ADJUST[16] = {
+    -1, -1, -1, -1, 2, 4, 6, 8,
+    -1, -1, -1, -1, 2, 4, 6, 8
+};
+
+typedef struct {
+    int32_t predictor;
+    int32_t index;
+} AdpcmState;
+
+//////////////////////////////////////////////////////////////////
+// Both the encoder and decoder reconstruct samples with this
+// function, so they stay in lockstep.
+//////////////////////////////////////////////////////////////////
+
+static int16_t adpcmStep(AdpcmState* state, uint8_t nibble) {
+    int32_t step = ADPCM_STEPS[state->index];
+    int32_t delta = step >> 3;
+
+    delta += (nibble & 4) ? step : 0;
+    delta += (nibble & 2) ? step >> 1 : 0;
+    delta += (nibble & 1) ? step >> 2 : 0;
+
+    int32_t predictor = state->predictor + ((nibble & 8) ? -delta : delta);
+    predictor = predictor < INT16_MIN ? INT16_MIN : predictor;
+    predictor = predictor > INT16_MAX ? INT16_MAX : predictor;
+
+    int32_t index = state->index + ADPCM_INDEX_ADJUST[nibble];
+    index = index < 0 ? 0 : index;
+    index = index > ADPCM_MAX_STEP_INDEX ? ADPCM_MAX_STEP_INDEX : index;
+
+    state->predictor = predictor;
+    state->index = index;
+
+    return (int16_t) predictor;
+}
+
+static uint8_t adpcmEncodeSample(AdpcmState* state, int16_t sample) {
+    int32_t step = ADPCM_STEPS[state->index];
+    int32_t diff = sample - state->predictor;
+    uint8_t nibble = 0;
+
+    if (diff < 0) {
+        nibble = 8;
+        diff = -diff;
+    }
+
+    if (diff >= step) {
+        nibble |= 4;
+        diff -= step;
+    }
+
+    step >>= 1;
+    if (diff >= step) {
+        nibble |= 2;
+        diff -= step;
+    }
+
+    step >>= 1;
+    if (diff >= step) {
+        nibble |= 1;
+    }
+
+    adpcmStep(state, nibble);
+
+    return nibble;
+}
+
+static void writeBlockHeader(uint8_t* block, AdpcmState* state) {
+    int16_t predictor = (int16_t) state->predictor;
+    memcpy(block, &predictor, sizeof(predictor));
+    block[2] = (uint8_t) state->index;
+    block[3] = 0;
+}
+
+static void readBlockHeader(const uint8_t* block, AdpcmState* state) {
+    int16_t predictor;
+    memcpy(&predictor, block, sizeof(predictor));
+    state->predictor = predictor;
+    state->index = block[2] > ADPCM_MAX_STEP_INDEX ? ADPCM_MAX_STEP_INDEX : block[2];
+}
+
+bool audio_encodeAdpcm(Data_Buffer* pcm, Data_Buffer* adpcm) {
+    int32_t frames = pcm->size / 4;
+    int32_t numBlocks = (frames + AUDIO_ADPCM_BLOCK_FRAMES - 1) / AUDIO_ADPCM_BLOCK_FRAMES;
+    int16_t* samples = (int16_t *) pcm->data;
+
+    uint8_t* data = (uint8_t *) malloc(numBlocks * AUDIO_ADPCM_BLOCK_BYTES);
+
+    if (!data) {
+        DEBUG_LOG("audio_encodeAdpcm: Unable to allocate ADPCM data.");
+        return false;
+    }
+
+    AdpcmState left = { 0 };
+    AdpcmState right = { 0 };
+
+    for (int32_t b = 0; b < numBlocks; ++b) {
+        uint8_t* block = data + b * AUDIO_ADPCM_BLOCK_BYTES;
+        int32_t firstFrame = b * AUDIO_ADPCM_BLOCK_FRAMES;
+
+        ////////////////////////////////////////////////////
+        // Re-seed the predictor from the source at each
+        // block so error doesn't accumulate across blocks.
+        ////////////////////////////////////////////////////
+
+        left.predictor = samples[firstFrame * 2];
+        right.predictor = samples[firstFrame * 2 + 1];
+        writeBlockHeader(block, &left);
+        writeBlockHeader(block + 4, &right);
+
+        uint8_t* nibbles = block + AUDIO_ADPCM_BLOCK_HEADER_BYTES;
+
+        for (int32_t i = 0; i < AUDIO_ADPCM_BLOCK_FRAMES; ++i) {
+            int32_t frame = firstFrame + i;
+            int16_t leftSample = frame < frames ? samples[frame * 2] : 0;
+            int16_t rightSample = frame < frames ? samples[frame * 2 + 1] : 0;
+
+            nibbles[i] = (uint8_t) (adpcmEncodeSample(&left, leftSample) | (adpcmEncodeSample(&right, rightSample) << 4));
+        }
+    }
+
+    adpcm->data = data;
+    adpcm->size = numBlocks * AUDIO_ADPCM_BLOCK_BYTES;
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////
+// Each channel's predictor depends on the previous sample, so
+// decoding is inherently serial within a channel. The two
+// channels are independent, though, and are decoded in the
+// same loop so their dependency chains overlap.
+//////////////////////////////////////////////////////////////////
+
+void audio_decodeAdpcmBlock(const uint8_t* block, int16_t* samples) {
+    AdpcmState left;
+    AdpcmState right;
+    readBlockHeader(block, &left);
+    readBlockHeader(block + 4, &right);
+
+    const uint8_t* nibbles = block + AUDIO_ADPCM_BLOCK_HEADER_BYTES;
+
+    for (int32_t i = 0; i < AUDIO_ADPCM_BLOCK_FRAMES; ++i) {
+        samples[i * 2] = adpcmStep(&left, nibbles[i] & 0xf);
+        samples[i * 2 + 1] = adpcmStep(&right, nibbles[i] >> 4);
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// Build the filter bank. Phase p is the kernel for an output
+// sample p / AUDIO_RESAMPLER_PHASES of the way between two input
+// samples, windowed with a Blackman window and normalized for
+// unity gain at DC. When downsampling, the cutoff is lowered to
+// the output Nyquist frequency to prevent aliasing.
+//////////////////////////////////////////////////////////////////
+
+static void buildResamplerFilters(float* filters, int32_t inRate, int32_t outRate) {
+    float cutoff = RESAMPLER_CUTOFF * (outRate < inRate ? (float) outRate / inRate : 1.0f);
+    float halfWidth = AUDIO_RESAMPLER_TAPS / 2;
+
+    for (int32_t p = 0; p < AUDIO_RESAMPLER_PHASES; ++p) {
+        float* filter = filters + p * AUDIO_RESAMPLER_TAPS;
+        float fraction = (float) p / AUDIO_RESAMPLER_PHASES;
+        float sum = 0.0f;
+
+        for (int32_t k = 0; k < AUDIO_RESAMPLER_TAPS; ++k) {
+            float d = k - (halfWidth - 1.0f) - fraction;
+            float x = RESAMPLER_PI * cutoff * d;
+            float sinc = x == 0.0f ? 1.0f : sinf(x) / x;
+            float w = RESAMPLER_PI * d / halfWidth;
+            float window = 0.42f + 0.5f * cosf(w) + 0.08f * cosf(2.0f * w);
+
+            filter[k] = sinc * window;
+            sum += filter[k];
+        }
+
+        for (int32_t k = 0; k < AUDIO_RESAMPLER_TAPS; ++k) {
+            filter[k] /= sum;
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////
+// Products are summed pairwise, halving the array each pass, so
+// the compiler can vectorize every step without having to
+// reassociate float math.
+//////////////////////////////////////////////////////////////////
+
+static float dotProduct(const float* samples, const float* filter) {
+    float products[AUDIO_RESAMPLER_TAPS];
+
+    for (int32_t i = 0; i < AUDIO_RESAMPLER_TAPS; ++i) {
+        products[i] = samples[i] * filter[i];
+    }
+
+    for (int32_t width = AUDIO_RESAMPLER_TAPS / 2; width >= 4; width /= 2) {
+        for (int32_t i = 0; i < width; ++i) {
+            products[i] += products[i + width];
+        }
+    }
+
+    return (products[0] + products[1]) + (products[2] + products[3]);
+}
+
+static int16_t toSample(float value) {
+    value = roundf(value);
+    value = value < INT16_MIN ? INT16_MIN : value;
+    value = value > INT16_MAX ? INT16_MAX : value;
+
+    return (int16_t) value;
+}
+
+bool audio_resample(Data_Buffer* in, int32_t inRate, Data_Buffer* out, int32_t outRate) {
+    int32_t inFrames = in->size / 4;
+    int32_t outFrames = (int32_t) (((int64_t) inFrames * outRate + inRate - 1) / inRate);
+    int16_t* inSamples = (int16_t *) in->data;
+
+    //////////////////////////////////////////////////////////
+    // Channels are split into separate, zero-padded arrays
+    // so every tap of every output sample is in bounds.
+    //////////////////////////////////////////////////////////
+
+    int32_t leadFrames = AUDIO_RESAMPLER_TAPS / 2;
+    int32_t paddedFrames = inFrames + AUDIO_RESAMPLER_TAPS + 1;
+
+    float* filters = (float *) malloc(AUDIO_RESAMPLER_PHASES * AUDIO_RESAMPLER_TAPS * sizeof(float));
+    if (!filters) {
+        goto ERROR_NO_RESOURCES;
+    }
+
+    float* left = (float *) calloc(paddedFrames * 2, sizeof(float));
+    if (!left) {
+        goto ERROR_FILTERS;
+    }
+    float* right = left + paddedFrames;
+
+    int16_t* outSamples = (int16_t *) malloc(outFrames * 4);
+    if (!outSamples) {
+        goto ERROR_CHANNELS;
+    }
+
+    buildResamplerFilters(filters, inRate, outRate);
+
+    for (int32_t i = 0; i < inFrames; ++i) {
+        left[leadFrames + i] = inSamples[i * 2];
+        right[leadFrames + i] = inSamples[i * 2 + 1];
+    }
+
+    for (int32_t i = 0; i < outFrames; ++i) {
+        int64_t position = (int64_t) i * inRate;
+        int32_t index = (int32_t) (position / outRate);
+        int32_t phase = (int32_t) ((position % outRate) * AUDIO_RESAMPLER_PHASES / outRate);
+
+        // First tap is (AUDIO_RESAMPLER_TAPS / 2 - 1) frames before index.
+        int32_t first = index + 1;
+        float* filter = filters + phase * AUDIO_RESAMPLER_TAPS;
+
+        outSamples[i * 2] = toSample(dotProduct(left + first, filter));
+        outSamples[i * 2 + 1] = toSample(dotProduct(right + first, filter));
+    }
+
+    free(left);
+    free(filters);
+
+    out->data = (uint8_t *) outSamples;
+    out->size = outFrames * 4;
+
+    return true;
+
+    ERROR_CHANNELS:
+    free(left);
+
+    ERROR_FILTERS:
+    free(filters);
+
+    ERROR_NO_RESOURCES:
+    DEBUG_LOG("audio_resample: Unable to allocate resampler buffers.");
+    return false;
+}
@@ -0,0 +1,69 @@
+////////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+// 
+// Copyright (c) 2021 Tarek Sherif
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _AUDIO_H_
+#define _AUDIO_H_
+#include <stdint.h>
+#include <stdbool.h>
+#include "data.h"
+
+//////////////////////////////////////////////////////////////////////
+// 4-bit IMA ADPCM in fixed-size, independently decodable blocks
+// of 16-bit stereo audio. Each block starts with a predictor and
+// step index for each channel, followed by one byte per frame
+// (left channel in the low nibble, right in the high nibble).
+// The last block is padded with silence.
+//////////////////////////////////////////////////////////////////////
+
+#define AUDIO_ADPCM_BLOCK_FRAMES 256
+#define AUDIO_ADPCM_BLOCK_SAMPLES (AUDIO_ADPCM_BLOCK_FRAMES * 2)
+#define AUDIO_ADPCM_BLOCK_HEADER_BYTES 8
+#define AUDIO_ADPCM_BLOCK_BYTES (AUDIO_ADPCM_BLOCK_HEADER_BYTES + AUDIO_ADPCM_BLOCK_FRAMES)
+
+//////////////////////////////////////////////////////////////////////
+// Polyphase windowed-sinc resampler. Each output sample is a
+// 32-tap dot product using the filter for the nearest of 256
+// fractional positions between input samples.
+//////////////////////////////////////////////////////////////////////
+
+#define AUDIO_RESAMPLER_PHASES 256
+#define AUDIO_RESAMPLER_TAPS 32
+
+//////////////////////////////////////////////////////////////////////////////
+// Audio codec functions.
+//
+// - audio_encodeAdpcm(): Encode interleaved 16-bit stereo PCM into ADPCM
+//      blocks. The output buffer is allocated and must be released with
+//      data_freeBuffer().
+// - audio_decodeAdpcmBlock(): Decode a single ADPCM block into
+//      AUDIO_ADPCM_BLOCK_SAMPLES interleaved 16-bit samples.
+// - audio_resample(): Convert interleaved 16-bit stereo PCM from one
+//      sample rate to another. The output buffer is allocated and must
+//      be released with data_freeBuffer().
+//////////////////////////////////////////////////////////////////////////////
+
+bool audio_encodeAdpcm(Data_Buffer* pcm, Data_Buffer* adpcm);
+void audio_decodeAdpcmBlock(const uint8_t* block, int16_t* samples);
+bool audio_resample(Data_Buffer* in, int32_t inRate, Data_Buffer* out, int32_t outRate);
+
+#endif
@@ -41,6 +41,12 @@
 #define SPACE_SHOOTER_DEFAULT_WINDOWED_HEIGHT 600
 #define SPACE_SHOOTER_MSAA_SAMPLES 4
 
+////////////
+// Assets
+////////////
+
+#define SPACE_SHOOTER_ASSET_ARCHIVE "./assets.pak"
+
 ///////////
 // Audio
 ///////////
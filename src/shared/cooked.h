@@ -0,0 +1,69 @@
+////////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+// 
+// Copyright (c) 2021 Tarek Sherif
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _COOKED_H_
+#define _COOKED_H_
+#include <stdint.h>
+
+//////////////////////////////////////////////////////////////////////
+// Formats written by the asset cooker (tools/cook-assets.c). Each
+// is a 16-byte header followed directly by data in the format the
+// game uses at runtime, so loading requires no transformation:
+// - Images: RGBA pixels, rows ordered bottom to top for GL. Indexed
+//      images (see Data_Image) store their palette of
+//      DATA_PALETTE_SIZE RGBA colors, followed by one index per pixel.
+// - Sounds: Interleaved 16-bit stereo PCM.
+// - Animations: The animations of a Data_Animations table, followed
+//      by its frames.
+// All values are little-endian.
+//////////////////////////////////////////////////////////////////////
+
+#define COOKED_IMAGE_MAGIC 0x474d4953 // "SIMG" little-endian
+#define COOKED_SOUND_MAGIC 0x444e5353 // "SSND" little-endian
+#define COOKED_ANIMATION_MAGIC 0x4d4e4153 // "SANM" little-endian
+
+#define COOKED_IMAGE_RGBA 0
+#define COOKED_IMAGE_INDEXED 1
+
+typedef struct {
+    uint32_t magic;
+    uint32_t width;
+    uint32_t height;
+    uint32_t format;
+} Cooked_ImageHeader;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t sampleRate;
+    uint32_t frames;
+    uint32_t reserved;
+} Cooked_SoundHeader;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t numAnimations;
+    uint32_t numFrames;
+    uint32_t reserved;
+} Cooked_AnimationHeader;
+
+#endif
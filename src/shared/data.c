@@ -23,15 +23,22 @@
 
 #include <malloc.h>
 #include "data.h"
+#include "platform-interface.h"
 
 void data_freeBuffer(Data_Buffer* buffer) {
     if (!buffer->data) {
         return;
     }
 
-    free(buffer->data);
+    if (buffer->view) {
+        platform_unmapFile(buffer->data);
+    } else {
+        free(buffer->data);
+    }
+
     buffer->data = NULL;
     buffer->size = 0;
+    buffer->view = false;
 }
 
 void data_freeImage(Data_Image* image) {
@@ -39,8 +46,35 @@ void data_freeImage(Data_Image* image) {
         return;
     }
 
-    free(image->data);
+    if (image->view) {
+        platform_unmapFile(image->data);
+    } else {
+        free(image->data);
+        free(image->palette);
+    }
+
     image->data = NULL;
+    image->palette = NULL;
     image->width = 0;
     image->height = 0;
-}
\ No newline at end of file
+    image->view = false;
+}
+
+// Frames are stored in the same allocation as the animations.
+void data_freeAnimations(Data_Animations* animations) {
+    if (!animations->animations) {
+        return;
+    }
+
+    if (animations->view) {
+        platform_unmapFile((uint8_t *) animations->animations);
+    } else {
+        free(animations->animations);
+    }
+
+    animations->animations = NULL;
+    animations->frames = NULL;
+    animations->numAnimations = 0;
+    animations->numFrames = 0;
+    animations->view = false;
+}
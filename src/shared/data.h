@@ -24,34 +24,75 @@
 #ifndef _DATA_H_
 #define _DATA_H_
 #include <stdint.h>
+#include <stdbool.h>
 
 //////////////////////////////////////////////////////////////////////
 // Data_Buffer represents arbitrary binary data along with its
-// size.
+// size. A view points into memory owned by the platform layer
+// (e.g. a memory-mapped file) and must be treated as read-only.
 //////////////////////////////////////////////////////////////////////
 
 typedef struct {
     uint8_t* data;
     uint32_t size;
+    bool view;
 } Data_Buffer;
 
 //////////////////////////////////////////////////////////////////////
 // Data_Image represents binary image data along with its
-// images.
+// images. Images are either RGBA, or indexed, with one byte per
+// pixel indexing into a palette of DATA_PALETTE_SIZE RGBA colors
+// (palette is NULL for RGBA images). Views are as for Data_Buffer,
+// and apply to both data and palette.
 //////////////////////////////////////////////////////////////////////
 
+#define DATA_PALETTE_SIZE 256
+
 typedef struct {
     uint8_t* data;
+    uint8_t* palette;
     int32_t width;
     int32_t height;
+    bool view;
 } Data_Image;
 
+//////////////////////////////////////////////////////////////////////
+// Data_Animations is a table of the animations in a sprite sheet.
+// The frames of all animations are stored contiguously as
+// (column, row) panel indices, two bytes per frame, and each
+// animation is an offset and count into them. Views are as for
+// Data_Buffer.
+//////////////////////////////////////////////////////////////////////
+
+typedef enum {
+    DATA_ANIMATION_END_LOOP,
+    DATA_ANIMATION_END_KILL
+} Data_AnimationEndBehavior;
+
+typedef struct {
+    uint16_t firstFrame;
+    uint8_t numFrames;
+    uint8_t endBehavior; // Data_AnimationEndBehavior
+} Data_Animation;
+
+typedef struct {
+    Data_Animation* animations;
+    uint8_t* frames;
+    int32_t numAnimations;
+    int32_t numFrames;
+    bool view;
+} Data_Animations;
+
 //////////////////////////////////////////////////////
-// Release resources for Data_Buffer and Data_Image
-// (also guard against double free errors).
+// Release resources for Data_Buffer, Data_Image and
+// Data_Animations
+// (also guard against double free errors). Views
+// release the mapping they point into with
+// platform_unmapFile().
 //////////////////////////////////////////////////////
 
 void data_freeBuffer(Data_Buffer* buffer);
 void data_freeImage(Data_Image* image);
+void data_freeAnimations(Data_Animations* animations);
 
 #endif
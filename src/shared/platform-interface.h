@@ -40,14 +40,36 @@
 //      even if gamepad is attached.
 // - hideQuitInstructions: Don't show quit instructions.
 // - noAudio: Don't initialize audio.
+// - simulationThread: The platform will call game_simulate() from its
+//      own thread, so game_update() and game_draw() only handle assets
+//      and drawing.
+// - tickRate: Simulation ticks per second, between 60 and 240, or 0
+//      for the default (60).
 ///////////////////////////////////////////////////////////////////////////////
 
 typedef struct {
     bool showInputToStartScreen;
     bool hideSystemInstructions;
     bool noAudio;
+    bool simulationThread;
+    int32_t tickRate;
 } Game_InitOptions;
 
+#define GAME_INPUT_MAX_EVENTS 16
+
+////////////////////////////////////////////////////////////////////////
+// Game_InputEvent is a press or release of the shoot input.
+//
+// Members:
+// - time: When it happened (ns, on the platform's clock).
+// - shoot: Whether shoot is down after it.
+////////////////////////////////////////////////////////////////////////
+
+typedef struct {
+    int64_t time;
+    bool shoot;
+} Game_InputEvent;
+
 ////////////////////////////////////////////////////////////////////////
 // Game_Input represents input from the platform layer into the game.
 //
@@ -58,6 +80,17 @@ typedef struct {
 // - lastShoot:Whether a shoot input was received on the last frame.
 // - keyboard: Whether this frame's input was from a keyboard. (Used
 //      to modify input instructions for the player).
+// - time: When the input first changed since the last call to
+//      platform_getInput() (ns, on the platform's clock), or 0 if it
+//      hasn't or the platform doesn't track it. Used to measure
+//      input latency.
+// - events: Shoot presses and releases since the last call to
+//      platform_getInput(), so taps between calls aren't lost.
+//      Platforms that don't track them leave eventCount at 0, and
+//      the game only sees changes to shoot.
+// - eventCount: Number of events.
+// - sampleTime: When the input was read (ns, on the same clock as
+//      events), or 0 if the platform doesn't track events.
 ////////////////////////////////////////////////////////////////////////
 
 typedef struct {
@@ -65,8 +98,78 @@ typedef struct {
     bool shoot;
     bool lastShoot;
     bool keyboard;
+    int64_t time;
+    Game_InputEvent events[GAME_INPUT_MAX_EVENTS];
+    int32_t eventCount;
+    int64_t sampleTime;
 } Game_Input;
 
+///////////////////////////////////////////////////////////////////////////
+// Game_SoundOptions describes how a sound competes for mixer voices
+// when many sounds are playing at once.
+//
+// Members:
+// - priority: Sounds can only take over voices from sounds with an
+//      equal or lower priority.
+// - maxInstances: Maximum number of voices that can play this sound
+//      at the same time (0 means no limit).
+// - compress: Store the sound ADPCM-compressed (~4x smaller) and
+//      decode it while mixing. Ignored by platforms that don't mix
+//      in software.
+///////////////////////////////////////////////////////////////////////////
+
+typedef struct {
+    int32_t priority;
+    int32_t maxInstances;
+    bool compress;
+} Game_SoundOptions;
+
+///////////////////////////////////////////////////////////////////////////
+// Game_PlaySoundOptions customizes a single playback of a sound.
+//
+// Members:
+// - loop: Whether the sound should loop.
+// - attenuation: Reduction in volume from 0.0 (full volume) to 1.0
+//      (silent).
+// - pan: Stereo position from -1.0 (left) to 1.0 (right).
+// - tick: Simulation tick the sound was triggered in. Identical
+//      requests from the same tick may be merged into one voice.
+///////////////////////////////////////////////////////////////////////////
+
+typedef struct {
+    bool loop;
+    float attenuation;
+    float pan;
+    uint32_t tick;
+} Game_PlaySoundOptions;
+
+///////////////////////////////////////////////////////////////////////////
+// Game_AudioStats reports the health of the audio mixer, so dropouts
+// can be traced to either a slow mixer or a starved audio thread.
+//
+// Members:
+// - xruns: Number of times the device ran out of data.
+// - droppedRequests: Number of play requests discarded because the
+//      queue was full or no voice could be taken over.
+// - mixTime: Time spent mixing the most recent period (ns).
+// - maxMixTime: Longest time spent mixing a single period (ns).
+// - periodTime: Duration of audio produced per period (ns). Mixing
+//      that takes longer than this will cause xruns.
+// - activeVoices: Number of voices currently playing.
+// - queueHighWater: Most play requests that have been waiting for
+//      the mixer at once.
+///////////////////////////////////////////////////////////////////////////
+
+typedef struct {
+    uint32_t xruns;
+    uint32_t droppedRequests;
+    int64_t mixTime;
+    int64_t maxMixTime;
+    int64_t periodTime;
+    int32_t activeVoices;
+    int32_t queueHighWater;
+} Game_AudioStats;
+
 /////////////////////////////////////////////////////////////////////////
 // Game lifecycle functions called by the platform layer and
 // implemented by the game layer.
@@ -76,17 +179,30 @@ typedef struct {
 //      (e.g. for web after user interaction).
 // - game_update(): Update game state based on time elapsed since
 //      last frame.
+// - game_simulate(): Run the simulation for time elapsed since the
+//      last call, when the simulationThread init option is set. Returns
+//      the time until the next tick is due. May be called from any
+//      single thread, which then also gets platform_getInput() and
+//      platform_playSound() calls.
 // - game_draw(): Draw current frame.
+// - game_drawnInputTime(): Get the time of the newest input (see
+//      Game_Input) reflected in the last frame drawn, for measuring
+//      input latency.
 // - game_resize(): Update rendering state to match the current window 
 //      size.
+// - game_reloadAsset(): Reload a shader or sprite that changed on disk
+//      (used for hot reloading in debug builds).
 // - game_close(): Release game resources.
 /////////////////////////////////////////////////////////////////////////
 
 bool game_init(Game_InitOptions* opts);
 void game_initAudio(void);
 void game_update(float elapsedTime); // In milliseconds
+float game_simulate(float elapsedTime); // In milliseconds
 void game_draw(void);
+int64_t game_drawnInputTime(void);
 void game_resize(int width, int height);
+void game_reloadAsset(const char* fileName);
 void game_close(void);
 
 ////////////////////////////////////////////////////////////////////////////
@@ -95,7 +211,11 @@ void game_close(void);
 //
 // - platform_getInput(): Get current input state.
 // - platform_loadSound(): Load a wave file into the audio system.
-// - platform_playSound(): Output sound to an audio device.
+//      Options may be NULL.
+// - platform_playSound(): Output sound to an audio device. Options
+//      may be NULL.
+// - platform_getAudioStats(): Get current audio mixer statistics.
+//      Returns false if the platform doesn't track them.
 // - platform_debugMessage(): Output a message intended for the developer 
 //      while debugging.
 // - platform_userMessage(): Output a message intended for the end
@@ -103,13 +223,46 @@ void game_close(void);
 // - platform_loadFile(): Load contents of a file into memory. 
 //      Optionally, null-terminate if the data will be used as a 
 //      string.
+// - platform_mapFile(): Get a read-only view of a file's contents
+//      without copying it, if the platform supports it (otherwise
+//      the contents are loaded as with platform_loadFile()).
+//      Release with data_freeBuffer().
+// - platform_unmapFile(): Release the mapping that `data` points
+//      into, which can be anywhere within a view returned by
+//      platform_mapFile(). Called by the data_free*() functions
+//      for views, and does nothing for memory that isn't a
+//      mapping of its own (e.g. a view into an archive).
+// - platform_addJob(): Run `function` with `data` on a worker thread.
+//      Returns an id for the job, or -1 if it couldn't be queued
+//      (e.g. the platform has no workers), in which case the caller
+//      should run it directly.
+// - platform_jobComplete(): Check whether a job has finished. Once
+//      it returns true, the job's results can be used and its id is
+//      released. Always true for -1.
+// - platform_waitForJob(): Block until a job has finished, then
+//      release its id.
+// - platform_startupPhase(): Mark the start of a named phase of
+//      startup, for timing. Each phase ends where the next begins,
+//      and the last ends when the first frame is presented. `name`
+//      must outlive startup. Main thread only.
+//
+// Jobs may call platform_loadFile(), platform_mapFile(),
+// platform_unmapFile() and platform_loadSound(), but nothing else
+// from the platform layer.
 ////////////////////////////////////////////////////////////////////////////
 
 void platform_getInput(Game_Input* input);
-int32_t platform_loadSound(const char* fileName);
-void platform_playSound(int32_t id, bool loop);
+int32_t platform_loadSound(const char* fileName, Game_SoundOptions* opts);
+void platform_playSound(int32_t id, Game_PlaySoundOptions* opts);
+bool platform_getAudioStats(Game_AudioStats* stats);
 void platform_debugMessage(const char* message);
 void platform_userMessage(const char* message);
 bool platform_loadFile(const char* fileName, Data_Buffer* buffer, bool nullTerminate);
+bool platform_mapFile(const char* fileName, Data_Buffer* buffer);
+void platform_unmapFile(const uint8_t* data);
+int32_t platform_addJob(void (*function)(void* data), void* data);
+bool platform_jobComplete(int32_t id);
+void platform_waitForJob(int32_t id);
+void platform_startupPhase(const char* name);
 
 #endif
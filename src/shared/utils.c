@@ -27,23 +27,72 @@
 #include "constants.h"
 #include "platform-interface.h"
 #include "debug.h"
+#include "audio.h"
+#include "cooked.h"
 #include "utils.h"
 
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#elif defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
 #define BMP_SIGNATURE 0x4d42
 #define BMP_BPP 32
 #define BMP_BITFIELD_COMPRESSION 3
+#define BMP_MIN_DIB_HEADER_SIZE 56 // Through the alpha mask
+#define BMP_MASKS_END 70
+#define BMP_SWAP_CHUNK_PIXELS 64
+#define PALETTE_HASH_SIZE 512 // Power of 2, at least twice DATA_PALETTE_SIZE
 
 #define WAVE_RIFF_SIGNATURE 0x46464952
 #define WAVE_TYPE_SIGNATURE 0x45564157
 #define WAVE_FMT_SIGNATURE 0x20746d66
 #define WAVE_DATA_SIGNATURE 0x61746164
 #define WAVE_PCM_FORMAT 1
+#define WAVE_EXTENSIBLE_FORMAT 0xfffe
+#define WAVE_MIN_FMT_SIZE 16
+#define WAVE_EXTENSIBLE_FMT_SIZE 40
+#define RIFF_HEADER_SIZE 12
+#define RIFF_CHUNK_HEADER_SIZE 8
+
+typedef struct {
+    uint8_t* data;
+    uint32_t size;
+} RiffChunk;
 
 
 void utils_init(void) {
     srand((uint32_t) time(NULL));
 }
 
+// Full barriers on both compilers, which is stronger
+// than the triple buffer needs, but these are only
+// called a few times per frame.
+int32_t utils_atomicLoad(volatile int32_t* value) {
+#ifdef _MSC_VER
+    return _InterlockedOr((volatile long *) value, 0);
+#else
+    return __atomic_load_n(value, __ATOMIC_SEQ_CST);
+#endif
+}
+
+int32_t utils_atomicExchange(volatile int32_t* value, int32_t newValue) {
+#ifdef _MSC_VER
+    return _InterlockedExchange((volatile long *) value, newValue);
+#else
+    return __atomic_exchange_n(value, newValue, __ATOMIC_SEQ_CST);
+#endif
+}
+
 float utils_lerp(float min, float max, float t) {
     return min + t * (max - min);
 }
@@ -89,131 +138,728 @@ void utils_uintToString(uint32_t n, char* buffer, int32_t bufferLength) {
     }
 }
 
-// NOTE(Tarek): Hardcoded to load 32bpp BGRA  
-static bool bmpToImage(Data_Buffer* imageData, Data_Image* image) {
-    uint32_t imageOffset   = *(uint32_t *) (imageData->data + 10);
-    int32_t width          = *(int32_t *)  (imageData->data + 18);
-    int32_t height         = *(int32_t *)  (imageData->data + 22);
+// Little-endian reads that don't depend on alignment.
+static uint16_t readUint16(const uint8_t* data) {
+    return (uint16_t) (data[0] | (data[1] << 8));
+}
 
-#ifdef SPACE_SHOOTER_DEBUG
-    uint16_t type = *(uint16_t *) imageData->data;
-    DEBUG_ASSERT(type == BMP_SIGNATURE, "utils_bmpToRgba: Invalid BMP data.");
+static uint32_t readUint32(const uint8_t* data) {
+    return (uint32_t) data[0] | ((uint32_t) data[1] << 8) | ((uint32_t) data[2] << 16) | ((uint32_t) data[3] << 24);
+}
+
+//////////////////////////////////////////////////////
+// Swizzle BGRA pixels to RGBA, 4 at a time with a
+// byte shuffle where one is available. src and dst
+// may be the same.
+//////////////////////////////////////////////////////
 
-    uint32_t dibHeaderSize = *(uint32_t *) (imageData->data + 14);
-    DEBUG_ASSERT(dibHeaderSize >= 70, "utils_bmpToRgba: Unsupported DIB header.");
+static void bgraToRgba(const uint8_t* src, uint8_t* dst, int32_t count) {
+    int32_t i = 0;
 
-    uint16_t bpp           = *(uint16_t *) (imageData->data + 28);
-    DEBUG_ASSERT(bpp == BMP_BPP, "utils_bmpToRgba: Unsupported bpp, must be 32.");
+#if defined(__SSSE3__)
+    __m128i indices = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
 
-    uint32_t compression   = *(uint32_t *) (imageData->data + 30);
-    DEBUG_ASSERT(compression == BMP_BITFIELD_COMPRESSION, "utils_bmpToRgba: Unsupported compression, must be BI_BITFIELDS (3).");
+    for (; i + 4 <= count; i += 4) {
+        __m128i pixels = _mm_loadu_si128((const __m128i *) (src + i * 4));
+        _mm_storeu_si128((__m128i *) (dst + i * 4), _mm_shuffle_epi8(pixels, indices));
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    // No byte shuffle in SSE2, so swap red and blue with shifts.
+    __m128i greenAlpha = _mm_set1_epi32((int) 0xff00ff00);
+    __m128i blue = _mm_set1_epi32(0x000000ff);
+
+    for (; i + 4 <= count; i += 4) {
+        __m128i pixels = _mm_loadu_si128((const __m128i *) (src + i * 4));
+        __m128i swapped = _mm_or_si128(
+            _mm_and_si128(pixels, greenAlpha),
+            _mm_or_si128(
+                _mm_and_si128(_mm_srli_epi32(pixels, 16), blue),
+                _mm_slli_epi32(_mm_and_si128(pixels, blue), 16)
+            )
+        );
+        _mm_storeu_si128((__m128i *) (dst + i * 4), swapped);
+    }
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    static const uint8_t INDICES[16] = { 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15 };
+    uint8x16_t indices = vld1q_u8(INDICES);
 
-    uint32_t redMask       = *(uint32_t *) (imageData->data + 54);
-    uint32_t greenMask     = *(uint32_t *) (imageData->data + 58);
-    uint32_t blueMask      = *(uint32_t *) (imageData->data + 62);
-    uint32_t alphaMask     = *(uint32_t *) (imageData->data + 66);
-    DEBUG_ASSERT(redMask == 0x00ff0000 && greenMask == 0x0000ff00 && blueMask == 0x000000ff && alphaMask == 0xff000000, "utils_bmpToRgba: Unsupported pixel layout, must be BGRA.");
+    for (; i + 4 <= count; i += 4) {
+        vst1q_u8(dst + i * 4, vqtbl1q_u8(vld1q_u8(src + i * 4), indices));
+    }
+#elif defined(__wasm_simd128__)
+    v128_t indices = wasm_i8x16_make(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+
+    for (; i + 4 <= count; i += 4) {
+        wasm_v128_store(dst + i * 4, wasm_i8x16_swizzle(wasm_v128_load(src + i * 4), indices));
+    }
 #endif
 
-    uint8_t* bmpImage = imageData->data + imageOffset;
-    
-    int32_t numPixels = width * height;
-    uint8_t* data = (uint8_t *) malloc(numPixels * 4);
+    for (; i < count; ++i) {
+        uint8_t b = src[i * 4];
+        uint8_t g = src[i * 4 + 1];
+        uint8_t r = src[i * 4 + 2];
+        uint8_t a = src[i * 4 + 3];
 
-    if (!data) {
-        DEBUG_LOG("utils_bmpToRgba: Unable to allocate image data.");
-        return false; 
+        dst[i * 4]     = r;
+        dst[i * 4 + 1] = g;
+        dst[i * 4 + 2] = b;
+        dst[i * 4 + 3] = a;
     }
+}
 
-    for (int32_t i = 0; i < numPixels;  ++i) {
-        int32_t row = i / width;
-        int32_t col = i % width;
-        int32_t mirrorRow = height - row - 1;
-        int32_t mirrorI = mirrorRow * width + col;
+// Swap two rows of BGRA pixels, converting both to RGBA.
+static void swapRowsToRgba(uint8_t* row1, uint8_t* row2, int32_t width) {
+    uint8_t chunk[BMP_SWAP_CHUNK_PIXELS * 4];
 
-        int32_t byteI = i * 4;
-        uint8_t b = bmpImage[byteI];
-        uint8_t g = bmpImage[byteI + 1];
-        uint8_t r = bmpImage[byteI + 2];
-        uint8_t a = bmpImage[byteI + 3];
+    for (int32_t i = 0; i < width; i += BMP_SWAP_CHUNK_PIXELS) {
+        int32_t count = width - i < BMP_SWAP_CHUNK_PIXELS ? width - i : BMP_SWAP_CHUNK_PIXELS;
+        uint8_t* pixels1 = row1 + i * 4;
+        uint8_t* pixels2 = row2 + i * 4;
 
-        int32_t mirrorByteI = mirrorI * 4;
-        data[mirrorByteI]     = r;
-        data[mirrorByteI + 1] = g;
-        data[mirrorByteI + 2] = b;
-        data[mirrorByteI + 3] = a;
+        bgraToRgba(pixels1, chunk, count);
+        bgraToRgba(pixels2, pixels1, count);
+        memcpy(pixels2, chunk, count * 4);
+    }
+}
+
+//////////////////////////////////////////////////////
+// Headers are validated against the size of the file
+// before anything is read from it, so truncated or
+// unsupported files fail to load rather than being
+// read out of bounds.
+//////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////
+// Pixel art uses few colors, so images with at most
+// DATA_PALETTE_SIZE distinct colors are converted in
+// place to one palette index per pixel. The first pass
+// only builds the palette, so images with too many
+// colors are left untouched as RGBA. Fully transparent
+// pixels all share one entry since their color is
+// never seen.
+//////////////////////////////////////////////////////
+
+static void indexImage(Data_Image* image) {
+    uint32_t* palette = (uint32_t *) calloc(DATA_PALETTE_SIZE, sizeof(uint32_t));
+
+    if (!palette) {
+        return;
+    }
+
+    // Open addressing table of colors, storing index + 1 (0 marks an empty slot).
+    uint32_t colors[PALETTE_HASH_SIZE];
+    uint16_t indices[PALETTE_HASH_SIZE] = { 0 };
+    int32_t numColors = 0;
+    int32_t numPixels = image->width * image->height;
+
+    for (int32_t pass = 0; pass < 2; ++pass) {
+        for (int32_t i = 0; i < numPixels; ++i) {
+            uint32_t color;
+            memcpy(&color, image->data + i * 4, 4);
+
+            if (image->data[i * 4 + 3] == 0) {
+                color = 0;
+            }
+
+            uint32_t slot = (color * 0x9e3779b1u) >> 23; // Top 9 bits
+            while (indices[slot] && colors[slot] != color) {
+                slot = (slot + 1) & (PALETTE_HASH_SIZE - 1);
+            }
+
+            if (!indices[slot]) {
+                if (numColors == DATA_PALETTE_SIZE) {
+                    free(palette);
+                    return;
+                }
+
+                colors[slot] = color;
+                palette[numColors] = color;
+                indices[slot] = (uint16_t) ++numColors;
+            }
+
+            // Index i is written behind pixel i, so pixels yet to be read are untouched.
+            if (pass == 1) {
+                image->data[i] = (uint8_t) (indices[slot] - 1);
+            }
+        }
+    }
+
+    // Shrinking can't fail in practice, but the larger buffer is fine if it does.
+    uint8_t* data = (uint8_t *) realloc(image->data, numPixels);
+
+    if (data) {
+        image->data = data;
+    }
+
+    image->palette = (uint8_t *) palette;
+}
+
+// NOTE(Tarek): Hardcoded to load 32bpp BGRA  
+static bool bmpToImage(Data_Buffer* imageData, Data_Image* image) {
+    if (imageData->size < BMP_MASKS_END || readUint16(imageData->data) != BMP_SIGNATURE) {
+        DEBUG_LOG("utils_bmpToRgba: Invalid BMP data.");
+        return false;
+    }
+
+    uint32_t imageOffset   = readUint32(imageData->data + 10);
+    uint32_t dibHeaderSize = readUint32(imageData->data + 14);
+    int32_t width          = (int32_t) readUint32(imageData->data + 18);
+    int32_t height         = (int32_t) readUint32(imageData->data + 22);
+    uint16_t bpp           = readUint16(imageData->data + 28);
+    uint32_t compression   = readUint32(imageData->data + 30);
+    uint32_t redMask       = readUint32(imageData->data + 54);
+    uint32_t greenMask     = readUint32(imageData->data + 58);
+    uint32_t blueMask      = readUint32(imageData->data + 62);
+    uint32_t alphaMask     = readUint32(imageData->data + 66);
+
+    if (dibHeaderSize < BMP_MIN_DIB_HEADER_SIZE) {
+        DEBUG_LOG("utils_bmpToRgba: Unsupported DIB header.");
+        return false;
+    }
+
+    if (bpp != BMP_BPP) {
+        DEBUG_LOG("utils_bmpToRgba: Unsupported bpp, must be 32.");
+        return false;
+    }
+
+    if (compression != BMP_BITFIELD_COMPRESSION) {
+        DEBUG_LOG("utils_bmpToRgba: Unsupported compression, must be BI_BITFIELDS (3).");
+        return false;
+    }
+
+    if (redMask != 0x00ff0000 || greenMask != 0x0000ff00 || blueMask != 0x000000ff || alphaMask != 0xff000000) {
+        DEBUG_LOG("utils_bmpToRgba: Unsupported pixel layout, must be BGRA.");
+        return false;
+    }
+
+    // Bottom-up images only (height > 0).
+    if (width <= 0 || height <= 0 || imageOffset + (uint64_t) width * height * 4 > imageData->size) {
+        DEBUG_LOG("utils_bmpToRgba: Invalid image dimensions.");
+        return false;
+    }
+
+    uint8_t* bmpImage = imageData->data + imageOffset;
+    int32_t rowBytes = width * 4;
+    uint8_t* data = NULL;
+
+    //////////////////////////////////////////////////////
+    // Rows are flipped and converted a row at a time.
+    // Views are read-only so they're converted into a
+    // new buffer, but a loaded copy of the file is
+    // converted in place and handed over to the image,
+    // so no second allocation is needed.
+    //////////////////////////////////////////////////////
+
+    if (imageData->view) {
+        data = (uint8_t *) malloc(height * rowBytes);
+
+        if (!data) {
+            DEBUG_LOG("utils_bmpToRgba: Unable to allocate image data.");
+            return false; 
+        }
+
+        for (int32_t row = 0; row < height; ++row) {
+            bgraToRgba(bmpImage + (height - row - 1) * rowBytes, data + row * rowBytes, width);
+        }
+    } else {
+        for (int32_t row = 0; row < height / 2; ++row) {
+            swapRowsToRgba(bmpImage + row * rowBytes, bmpImage + (height - row - 1) * rowBytes, width);
+        }
+
+        if (height % 2 == 1) {
+            uint8_t* middleRow = bmpImage + (height / 2) * rowBytes;
+            bgraToRgba(middleRow, middleRow, width);
+        }
+
+        // Move the pixels to the start of the allocation so it can be freed.
+        data = imageData->data;
+        memmove(data, bmpImage, height * rowBytes);
+
+        imageData->data = NULL;
+        imageData->size = 0;
     }
 
     image->data = data;
+    image->palette = NULL;
     image->width = width;
     image->height = height;
+    image->view = false;
+
+    indexImage(image);
 
     return true;
 }
 
-// NOTE(Tarek): Hardcoded to load 2-channel 44.1kHz 16-bit data, with RIFF, fmt and data chunks sequential.
-static bool wavToSound(Data_Buffer* soundData, Data_Buffer* sound) {
-    uint32_t fmtSize = *(uint32_t *) (soundData->data + 16);
-    int32_t dataOffset = fmtSize + 20;
-        
-#ifdef SPACE_SHOOTER_DEBUG
-    // "RIFF" little-endian
-    uint32_t riffType = *(uint32_t *) soundData->data;
-    DEBUG_ASSERT(riffType == WAVE_RIFF_SIGNATURE, "utils_wavToSound: Invalid WAVE file. Missing RIFF chunk.");
-    
-    // fileSize == size of file - 4 bytes each for this and the previous field.
-    uint32_t fileSize = *(uint32_t *) (soundData->data + 4);
-    DEBUG_ASSERT(fileSize == soundData->size - 8, "utils_wavToSound: Invalid WAVE file. File size incorrect.");
-
-    // "WAVE" little-endian
-    uint32_t fileFormat = *(uint32_t *) (soundData->data + 8);
-    DEBUG_ASSERT(fileFormat == WAVE_TYPE_SIGNATURE, "utils_wavToSound: Invalid WAVE file. Missing WAVE chunk.");
-
-    // "fmt " little-endian
-    uint32_t fmtType = *(uint32_t *) (soundData->data + 12);
-    DEBUG_ASSERT(fmtType == WAVE_FMT_SIGNATURE, "utils_wavToSound: Invalid WAVE file. Missing fmt chunk.");
-    
-
-    uint16_t formatCode = *(uint16_t *) (soundData->data + 20);            
-    uint16_t channels   = *(uint16_t *) (soundData->data + 22);            
-    uint32_t rate       = *(uint32_t *) (soundData->data + 24);            
-    uint16_t bps        = *(uint16_t *) (soundData->data + 34);
-    DEBUG_ASSERT(formatCode == WAVE_PCM_FORMAT, "utils_wavToSound: Invalid audio data. Audio must be uncompressed.");
-    DEBUG_ASSERT(channels == SPACE_SHOOTER_AUDIO_CHANNELS, "utils_wavToSound: Invalid audio data. Audio must be stereo.");
-    DEBUG_ASSERT(rate == SPACE_SHOOTER_AUDIO_SAMPLE_RATE, "utils_wavToSound: Invalid audio data. Audio must be 44.1k samples per second.");
-    DEBUG_ASSERT(bps == SPACE_SHOOTER_AUDIO_BPS, "utils_wavToSound: Invalid audio data. Audio must be 16bps.");
-
-    // "data" little-endian
-    uint32_t dataType = *(uint32_t *) (soundData->data + dataOffset);
-    DEBUG_ASSERT(dataType == WAVE_DATA_SIGNATURE, "utils_wavToSound: Invalid WAVE file. Missing data chunk.");
-#endif
+static bool isCooked(Data_Buffer* buffer, uint32_t magic) {
+    return buffer->size >= sizeof(Cooked_ImageHeader) && *(uint32_t *) buffer->data == magic;
+}
+
+//////////////////////////////////////////////////////
+// Cooked data is already in its runtime format, so
+// views are used directly. Owned buffers are copied
+// since the caller frees the file data.
+//////////////////////////////////////////////////////
+
+static bool cookedToImage(Data_Buffer* imageData, Data_Image* image) {
+    Cooked_ImageHeader* header = (Cooked_ImageHeader *) imageData->data;
+    bool indexed = header->format == COOKED_IMAGE_INDEXED;
+    uint8_t* palette = indexed ? imageData->data + sizeof(Cooked_ImageHeader) : NULL;
+    uint32_t paletteSize = indexed ? DATA_PALETTE_SIZE * 4 : 0;
+    uint8_t* pixels = imageData->data + sizeof(Cooked_ImageHeader) + paletteSize;
+    uint64_t size = (uint64_t) header->width * header->height * (indexed ? 1 : 4);
+
+    if (header->width > INT32_MAX || header->height > INT32_MAX || paletteSize + size > imageData->size - sizeof(Cooked_ImageHeader)) {
+        DEBUG_LOG("utils_cookedToImage: Invalid cooked image.");
+        return false;
+    }
+
+    if (imageData->view) {
+        image->data = pixels;
+        image->palette = palette;
+    } else {
+        image->data = (uint8_t *) malloc((size_t) size);
+        image->palette = indexed ? (uint8_t *) malloc(paletteSize) : NULL;
+
+        if (!image->data || (indexed && !image->palette)) {
+            DEBUG_LOG("utils_cookedToImage: Unable to allocate image data.");
+            free(image->data);
+            free(image->palette);
+            image->data = NULL;
+            image->palette = NULL;
+            return false;
+        }
+
+        memcpy(image->data, pixels, (size_t) size);
+
+        if (indexed) {
+            memcpy(image->palette, palette, paletteSize);
+        }
+    }
 
-    uint32_t dataSize = *(uint32_t *) (soundData->data + dataOffset + 4);
-    sound->size = dataSize;
-    sound->data = (uint8_t *) malloc(dataSize);
+    image->width = header->width;
+    image->height = header->height;
+    image->view = imageData->view;
 
-    if (!sound->data) {
+    return true;
+}
+
+// Read a little-endian PCM sample of 1-4 bytes and scale it to 16 bits.
+static int16_t readPcmSample(const uint8_t* sample, int32_t bytes) {
+    switch (bytes) {
+        case 1: return (int16_t) ((sample[0] - 128) * 256); // 8-bit PCM is unsigned
+        case 2: return (int16_t) (sample[0] | (sample[1] << 8));
+        default: return (int16_t) (sample[bytes - 2] | (sample[bytes - 1] << 8));
+    }
+}
+
+//////////////////////////////////////////////////////
+// Walk the chunks of a RIFF file looking for the one
+// with the given id. Chunks we don't care about (LIST,
+// fact, etc.) are skipped, along with the pad byte that
+// follows odd-sized chunks. Chunks that claim to run
+// past the end of the file are clamped to it, since
+// some writers leave the size of the last chunk unset.
+//////////////////////////////////////////////////////
+
+static bool findRiffChunk(Data_Buffer* buffer, uint32_t id, RiffChunk* chunk) {
+    uint64_t offset = RIFF_HEADER_SIZE;
+
+    while (offset + RIFF_CHUNK_HEADER_SIZE <= buffer->size) {
+        uint32_t chunkId = readUint32(buffer->data + offset);
+        uint32_t chunkSize = readUint32(buffer->data + offset + 4);
+        uint64_t available = buffer->size - offset - RIFF_CHUNK_HEADER_SIZE;
+
+        if (chunkId == id) {
+            chunk->data = buffer->data + offset + RIFF_CHUNK_HEADER_SIZE;
+            chunk->size = chunkSize < available ? chunkSize : (uint32_t) available;
+
+            return true;
+        }
+
+        offset += RIFF_CHUNK_HEADER_SIZE + (uint64_t) chunkSize + (chunkSize & 1);
+    }
+
+    return false;
+}
+
+static bool wavToSound(Data_Buffer* soundData, Data_Buffer* sound, int32_t sampleRate) {
+    // "RIFF" and "WAVE" little-endian
+    if (soundData->size < RIFF_HEADER_SIZE || readUint32(soundData->data) != WAVE_RIFF_SIGNATURE || readUint32(soundData->data + 8) != WAVE_TYPE_SIGNATURE) {
+        DEBUG_LOG("utils_wavToSound: Invalid WAVE file. Missing RIFF header.");
+        return false;
+    }
+
+    RiffChunk fmt = { 0 };
+    if (!findRiffChunk(soundData, WAVE_FMT_SIGNATURE, &fmt) || fmt.size < WAVE_MIN_FMT_SIZE) {
+        DEBUG_LOG("utils_wavToSound: Invalid WAVE file. Missing fmt chunk.");
+        return false;
+    }
+
+    RiffChunk dataChunk = { 0 };
+    if (!findRiffChunk(soundData, WAVE_DATA_SIGNATURE, &dataChunk)) {
+        DEBUG_LOG("utils_wavToSound: Invalid WAVE file. Missing data chunk.");
+        return false;
+    }
+
+    uint16_t formatCode = readUint16(fmt.data);
+    uint16_t channels   = readUint16(fmt.data + 2);
+    uint32_t rate       = readUint32(fmt.data + 4);
+    uint16_t bps        = readUint16(fmt.data + 14);
+
+    if (formatCode == WAVE_EXTENSIBLE_FORMAT && fmt.size >= WAVE_EXTENSIBLE_FMT_SIZE) {
+        // Sub-format GUID starts with the format code.
+        formatCode = readUint16(fmt.data + 24);
+    }
+
+    if (formatCode != WAVE_PCM_FORMAT || channels == 0 || rate == 0 || bps == 0 || bps > 32 || bps % 8 != 0) {
+        DEBUG_LOG("utils_wavToSound: Unsupported audio data. Audio must be uncompressed 8, 16, 24 or 32-bit PCM.");
+        return false;
+    }
+
+    uint32_t dataSize = dataChunk.size;
+    uint8_t* data = dataChunk.data;
+    int32_t sampleBytes = bps / 8;
+    int32_t frameBytes = sampleBytes * channels;
+    int32_t frames = dataSize / frameBytes;
+
+    //////////////////////////////////////////////////////
+    // If the file is a view and already in the output
+    // format, point the sound directly at its samples.
+    //////////////////////////////////////////////////////
+
+    bool outputFormat = channels == SPACE_SHOOTER_AUDIO_CHANNELS && bps == SPACE_SHOOTER_AUDIO_BPS && (int32_t) rate == sampleRate;
+    if (outputFormat && soundData->view) {
+        sound->data = data;
+        sound->size = frames * 4;
+        sound->view = true;
+
+        return true;
+    }
+
+    //////////////////////////////////////////////////////
+    // Convert to 16-bit stereo. Mono is copied to both
+    // channels, and channels past the first two are
+    // dropped.
+    //////////////////////////////////////////////////////
+
+    Data_Buffer stereo = {
+        .data = (uint8_t *) malloc(frames * 4),
+        .size = frames * 4
+    };
+
+    if (!stereo.data) {
         DEBUG_LOG("utils_wavToSound: Unable to allocate sound data.");
         return false; 
     }
 
-    memcpy(sound->data, soundData->data + dataOffset + 8, dataSize);
+    if (channels == SPACE_SHOOTER_AUDIO_CHANNELS && bps == SPACE_SHOOTER_AUDIO_BPS) {
+        memcpy(stereo.data, data, stereo.size);
+    } else {
+        int16_t* samples = (int16_t *) stereo.data;
+        int32_t rightOffset = channels > 1 ? sampleBytes : 0;
+
+        for (int32_t i = 0; i < frames; ++i) {
+            uint8_t* frame = data + i * frameBytes;
+            samples[i * 2] = readPcmSample(frame, sampleBytes);
+            samples[i * 2 + 1] = readPcmSample(frame + rightOffset, sampleBytes);
+        }
+    }
+
+    if ((int32_t) rate == sampleRate) {
+        *sound = stereo;
+
+        return true;
+    }
+
+    bool result = audio_resample(&stereo, rate, sound, sampleRate);
+    data_freeBuffer(&stereo);
+
+    return result;
+}
+
+static bool cookedToSound(Data_Buffer* soundData, Data_Buffer* sound, int32_t sampleRate) {
+    Cooked_SoundHeader* header = (Cooked_SoundHeader *) soundData->data;
+    uint64_t size = (uint64_t) header->frames * 4;
+
+    if (header->sampleRate == 0 || size > soundData->size - sizeof(Cooked_SoundHeader)) {
+        DEBUG_LOG("utils_cookedToSound: Invalid cooked sound.");
+        return false;
+    }
+
+    Data_Buffer samples = {
+        .data = soundData->data + sizeof(Cooked_SoundHeader),
+        .size = (uint32_t) size,
+        .view = true
+    };
+
+    // Sounds are cooked at SPACE_SHOOTER_AUDIO_SAMPLE_RATE, so
+    // this only happens if the device runs at a different rate.
+    if ((int32_t) header->sampleRate != sampleRate) {
+        return audio_resample(&samples, header->sampleRate, sound, sampleRate);
+    }
+
+    if (soundData->view) {
+        *sound = samples;
+
+        return true;
+    }
+
+    sound->data = (uint8_t *) malloc(samples.size);
+
+    if (!sound->data) {
+        DEBUG_LOG("utils_cookedToSound: Unable to allocate sound data.");
+        return false; 
+    }
+
+    memcpy(sound->data, samples.data, samples.size);
+    sound->size = samples.size;
+    sound->view = false;
 
     return true;
 }
 
 bool utils_loadBmpData(const char* fileName, Data_Image* image) {
     Data_Buffer imageData = { 0 };
-    bool result = platform_loadFile(fileName, &imageData, false) && bmpToImage(&imageData, image);
-    data_freeBuffer(&imageData);
+
+    if (!platform_mapFile(fileName, &imageData)) {
+        return false;
+    }
+
+    bool result = isCooked(&imageData, COOKED_IMAGE_MAGIC) ? cookedToImage(&imageData, image) : bmpToImage(&imageData, image);
+
+    // A view takes over the file's mapping, and releases it when freed.
+    if (!result || !image->view) {
+        data_freeBuffer(&imageData);
+    }
 
     return result;
 }
 
-bool utils_loadWavData(const char* fileName, Data_Buffer* sound) {
+bool utils_loadWavData(const char* fileName, Data_Buffer* sound, int32_t sampleRate) {
     Data_Buffer soundData = { 0 };
-    bool result = platform_loadFile(fileName, &soundData, false) && wavToSound(&soundData, sound);
-    data_freeBuffer(&soundData);
+
+    if (!platform_mapFile(fileName, &soundData)) {
+        return false;
+    }
+
+    bool result = isCooked(&soundData, COOKED_SOUND_MAGIC) ? cookedToSound(&soundData, sound, sampleRate) : wavToSound(&soundData, sound, sampleRate);
+
+    if (!result || !sound->view) {
+        data_freeBuffer(&soundData);
+    }
+
+    return result;
+}
+
+//////////////////////////////////////////////////////
+// Animation files are text, one animation per line:
+// an end behavior (`loop` or `kill`) followed by the
+// frames as `column,row` panel indices, e.g.
+//
+//     # Explosion
+//     kill 0,0 1,0 2,0 3,0 4,0
+//
+// Blank lines and anything after a `#` are ignored.
+// Files are parsed twice: once to count animations
+// and frames so the table can be allocated in one
+// block, and again to fill it in.
+//////////////////////////////////////////////////////
+
+static bool isAnimationSpace(uint8_t c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+// True at the end of a token.
+static bool isAnimationDelimiter(const uint8_t* text, uint32_t i, uint32_t end) {
+    return i == end || isAnimationSpace(text[i]) || text[i] == '#';
+}
+
+static bool readAnimationKeyword(const uint8_t* text, uint32_t* i, uint32_t end, const char* keyword) {
+    uint32_t length = (uint32_t) strlen(keyword);
+
+    if (end - *i < length || memcmp(text + *i, keyword, length) != 0 || !isAnimationDelimiter(text, *i + length, end)) {
+        return false;
+    }
+
+    *i += length;
+
+    return true;
+}
+
+static bool readAnimationIndex(const uint8_t* text, uint32_t* i, uint32_t end, uint8_t* index) {
+    int32_t value = 0;
+    uint32_t start = *i;
+
+    while (*i < end && text[*i] >= '0' && text[*i] <= '9') {
+        value = value * 10 + (text[*i] - '0');
+
+        if (value > UINT8_MAX) {
+            return false;
+        }
+
+        ++*i;
+    }
+
+    *index = (uint8_t) value;
+
+    return *i > start;
+}
+
+static bool parseAnimations(Data_Buffer* text, Data_Animations* table) {
+    const uint8_t* data = text->data;
+    int32_t numAnimations = 0;
+    int32_t numFrames = 0;
+    uint32_t lineStart = 0;
+
+    while (lineStart < text->size) {
+        uint32_t end = lineStart;
+        while (end < text->size && data[end] != '\n') {
+            ++end;
+        }
+
+        uint32_t i = lineStart;
+        lineStart = end + 1;
+
+        while (i < end && isAnimationSpace(data[i])) {
+            ++i;
+        }
+
+        if (i == end || data[i] == '#') {
+            continue;
+        }
+
+        Data_AnimationEndBehavior endBehavior = DATA_ANIMATION_END_LOOP;
+
+        if (readAnimationKeyword(data, &i, end, "kill")) {
+            endBehavior = DATA_ANIMATION_END_KILL;
+        } else if (!readAnimationKeyword(data, &i, end, "loop")) {
+            return false;
+        }
+
+        int32_t firstFrame = numFrames;
+
+        while (true) {
+            while (i < end && isAnimationSpace(data[i])) {
+                ++i;
+            }
+
+            if (i == end || data[i] == '#') {
+                break;
+            }
+
+            uint8_t column, row;
+
+            if (!readAnimationIndex(data, &i, end, &column) || i == end || data[i++] != ',' || !readAnimationIndex(data, &i, end, &row) || !isAnimationDelimiter(data, i, end)) {
+                return false;
+            }
+
+            if (table->animations) {
+                table->frames[numFrames * 2] = column;
+                table->frames[numFrames * 2 + 1] = row;
+            }
+
+            ++numFrames;
+        }
+
+        int32_t count = numFrames - firstFrame;
+
+        if (count == 0 || count > UINT8_MAX || firstFrame > UINT16_MAX) {
+            return false;
+        }
+
+        if (table->animations) {
+            table->animations[numAnimations] = (Data_Animation) {
+                .firstFrame = (uint16_t) firstFrame,
+                .numFrames = (uint8_t) count,
+                .endBehavior = (uint8_t) endBehavior
+            };
+        }
+
+        ++numAnimations;
+    }
+
+    table->numAnimations = numAnimations;
+    table->numFrames = numFrames;
+
+    return numAnimations > 0;
+}
+
+static bool textToAnimations(Data_Buffer* text, Data_Animations* animations) {
+    Data_Animations table = { 0 };
+
+    if (!parseAnimations(text, &table)) {
+        DEBUG_LOG("utils_textToAnimations: Invalid animation data.");
+        return false;
+    }
+
+    size_t animationsSize = (size_t) table.numAnimations * sizeof(Data_Animation);
+    table.animations = (Data_Animation *) malloc(animationsSize + (size_t) table.numFrames * 2);
+
+    if (!table.animations) {
+        DEBUG_LOG("utils_textToAnimations: Unable to allocate animation data.");
+        return false;
+    }
+
+    table.frames = (uint8_t *) table.animations + animationsSize;
+    parseAnimations(text, &table);
+    *animations = table;
+
+    return true;
+}
+
+static bool cookedToAnimations(Data_Buffer* animationData, Data_Animations* animations) {
+    Cooked_AnimationHeader* header = (Cooked_AnimationHeader *) animationData->data;
+    uint64_t animationsSize = (uint64_t) header->numAnimations * sizeof(Data_Animation);
+    uint64_t framesSize = (uint64_t) header->numFrames * 2;
+
+    if (header->numAnimations == 0 || animationsSize + framesSize > animationData->size - sizeof(Cooked_AnimationHeader)) {
+        DEBUG_LOG("utils_cookedToAnimations: Invalid cooked animations.");
+        return false;
+    }
+
+    Data_Animation* table = (Data_Animation *) (animationData->data + sizeof(Cooked_AnimationHeader));
+
+    // Checked up front so the game can index frames without bounds checks.
+    for (uint32_t i = 0; i < header->numAnimations; ++i) {
+        if (table[i].numFrames == 0 || table[i].firstFrame + table[i].numFrames > header->numFrames) {
+            DEBUG_LOG("utils_cookedToAnimations: Invalid cooked animations.");
+            return false;
+        }
+    }
+
+    if (animationData->view) {
+        animations->animations = table;
+    } else {
+        animations->animations = (Data_Animation *) malloc((size_t) (animationsSize + framesSize));
+
+        if (!animations->animations) {
+            DEBUG_LOG("utils_cookedToAnimations: Unable to allocate animation data.");
+            return false;
+        }
+
+        memcpy(animations->animations, table, (size_t) (animationsSize + framesSize));
+    }
+
+    animations->frames = (uint8_t *) animations->animations + animationsSize;
+    animations->numAnimations = header->numAnimations;
+    animations->numFrames = header->numFrames;
+    animations->view = animationData->view;
+
+    return true;
+}
+
+bool utils_loadAnimationData(const char* fileName, Data_Animations* animations) {
+    Data_Buffer animationData = { 0 };
+
+    if (!platform_mapFile(fileName, &animationData)) {
+        return false;
+    }
+
+    bool result = isCooked(&animationData, COOKED_ANIMATION_MAGIC) ? cookedToAnimations(&animationData, animations) : textToAnimations(&animationData, animations);
+
+    if (!result || !animations->view) {
+        data_freeBuffer(&animationData);
+    }
 
     return result;
 }
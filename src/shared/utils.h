@@ -31,6 +31,8 @@
 // Collection of smaller utility functions.
 //
 // - utils_init(): initialization (for random number generator).
+// - utils_atomicLoad(): read a value shared between threads.
+// - utils_atomicExchange(): replace a value shared between threads, returning the old one.
 // - utils_lerp(): linear interpolation between min and max
 // - utils_randomRange(): random float between min and max
 // - utils_boxCollision(): detect collision between boxes defined by min1/max1 and min2/max2,
@@ -38,18 +40,27 @@
 // - utils_uintToString(uint32_t n, char* buffer, int32_t bufferLength): convert a unsigned
 //      integer to a string. 
 // - utils_loadBmpData(): Parse the image data out of a BMP file. Note this function is hardcoded to 
-//      load 32bpp, uncompressed BGRA data (the format output by gimp).
-// - utils_loadWavData(): Parse audio data out of a WAVE file. Note this function is hardcoded
-//      to load 2-channel, 44.1kHz, 16-bit data, and the chunks must be in the order RIFF, fmt 
-//      then data.
+//      load 32bpp, uncompressed BGRA data (the format output by gimp). Images with few enough
+//      colors are returned indexed (see Data_Image). Cooked images (see cooked.h)
+//      are used as is, and point directly into the file if it's a view.
+// - utils_loadWavData(): Parse audio data out of a WAVE file, converting it to 16-bit stereo
+//      at `sampleRate`. Any uncompressed PCM rate, channel count and 8/16/24/32-bit depth is
+//      accepted, and chunks other than fmt and data are skipped. Cooked sounds (see
+//      cooked.h) are used as is unless they need resampling.
+// - utils_loadAnimationData(): Parse a sprite sheet's animation table out of an animation file
+//      (see utils.c for the format). Cooked animations (see cooked.h) are used as is, and point
+//      directly into the file if it's a view.
 //////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void utils_init(void);
+int32_t utils_atomicLoad(volatile int32_t* value);
+int32_t utils_atomicExchange(volatile int32_t* value, int32_t newValue);
 float utils_lerp(float min, float max, float t);
 float utils_randomRange(float min, float max);
 bool utils_boxCollision(float min1[2], float max1[2], float min2[2], float max2[2], float scale);
 void utils_uintToString(uint32_t n, char* buffer, int32_t bufferLength); 
 bool utils_loadBmpData(const char* fileName, Data_Image* image);
-bool utils_loadWavData(const char* fileName, Data_Buffer* sound);
+bool utils_loadWavData(const char* fileName, Data_Buffer* sound, int32_t sampleRate);
+bool utils_loadAnimationData(const char* fileName, Data_Animations* animations);
 
 #endif
\ No newline at end of file
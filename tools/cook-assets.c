@@ -0,0 +1,217 @@
+////////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+// 
+// Copyright (c) 2021 Tarek Sherif
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////
+// Convert assets into the formats the game uses at runtime (see
+// cooked.h) so loading them is a straight copy or view.
+//
+// Usage: cook-assets <output-dir> <asset>...
+//
+// Sprites (.bmp) become flipped indexed or RGBA images, sounds (.wav) become
+// 16-bit stereo PCM at SPACE_SHOOTER_AUDIO_SAMPLE_RATE and animations (.anim)
+// become packed animation tables. Each is
+// written to the same path under <output-dir>, which must already
+// contain the asset directories. Other assets are ignored.
+//
+// Parsing is done by the game's own loaders, so this links against
+// the shared code and provides the one platform function it uses.
+//////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../src/shared/constants.h"
+#include "../src/shared/platform-interface.h"
+#include "../src/shared/cooked.h"
+#include "../src/shared/utils.h"
+
+#define MAX_PATH_LENGTH 1024
+
+bool platform_mapFile(const char* fileName, Data_Buffer* buffer) {
+    FILE* file = fopen(fileName, "rb");
+
+    if (!file) {
+        goto ERROR_NO_RESOURCES;
+    }
+
+    if (fseek(file, 0, SEEK_END) != 0) {
+        goto ERROR_FILE_OPENED;
+    }
+
+    long size = ftell(file);
+    if (size <= 0 || fseek(file, 0, SEEK_SET) != 0) {
+        goto ERROR_FILE_OPENED;
+    }
+
+    uint8_t* data = (uint8_t *) malloc(size);
+    if (!data) {
+        goto ERROR_FILE_OPENED;
+    }
+
+    if (fread(data, 1, size, file) != (size_t) size) {
+        goto ERROR_DATA_ALLOCATED;
+    }
+
+    fclose(file);
+
+    buffer->data = data;
+    buffer->size = (uint32_t) size;
+    buffer->view = false;
+
+    return true;
+
+    ERROR_DATA_ALLOCATED:
+    free(data);
+
+    ERROR_FILE_OPENED:
+    fclose(file);
+
+    ERROR_NO_RESOURCES:
+    return false;
+}
+
+// Files are loaded as copies, so there are no mappings to release.
+void platform_unmapFile(const uint8_t* data) { }
+
+static bool hasExtension(const char* name, const char* extension) {
+    size_t nameLength = strlen(name);
+    size_t extensionLength = strlen(extension);
+
+    return nameLength > extensionLength && strcmp(name + nameLength - extensionLength, extension) == 0;
+}
+
+// `table` (e.g. a palette) is written between the header and data, and may be NULL.
+static bool writeAsset(const char* fileName, const void* header, size_t headerSize, const void* table, size_t tableSize, const void* data, size_t size) {
+    FILE* file = fopen(fileName, "wb");
+
+    if (!file) {
+        fprintf(stderr, "cook-assets: Unable to open %s.\n", fileName);
+        return false;
+    }
+
+    bool written = fwrite(header, headerSize, 1, file) == 1 && (!table || fwrite(table, 1, tableSize, file) == tableSize) && fwrite(data, 1, size, file) == size;
+
+    if (fclose(file) != 0 || !written) {
+        fprintf(stderr, "cook-assets: Unable to write %s.\n", fileName);
+        remove(fileName);
+        return false;
+    }
+
+    return true;
+}
+
+static bool cookImage(const char* name, const char* output) {
+    Data_Image image = { 0 };
+
+    if (!utils_loadBmpData(name, &image)) {
+        fprintf(stderr, "cook-assets: Unable to load image %s.\n", name);
+        return false;
+    }
+
+    Cooked_ImageHeader header = {
+        .magic = COOKED_IMAGE_MAGIC,
+        .width = image.width,
+        .height = image.height,
+        .format = image.palette ? COOKED_IMAGE_INDEXED : COOKED_IMAGE_RGBA
+    };
+
+    size_t paletteSize = image.palette ? DATA_PALETTE_SIZE * 4 : 0;
+    size_t pixelSize = image.palette ? 1 : 4;
+    bool result = writeAsset(output, &header, sizeof(header), image.palette, paletteSize, image.data, (size_t) image.width * image.height * pixelSize);
+    data_freeImage(&image);
+
+    return result;
+}
+
+static bool cookSound(const char* name, const char* output) {
+    Data_Buffer sound = { 0 };
+
+    if (!utils_loadWavData(name, &sound, SPACE_SHOOTER_AUDIO_SAMPLE_RATE)) {
+        fprintf(stderr, "cook-assets: Unable to load sound %s.\n", name);
+        return false;
+    }
+
+    Cooked_SoundHeader header = {
+        .magic = COOKED_SOUND_MAGIC,
+        .sampleRate = SPACE_SHOOTER_AUDIO_SAMPLE_RATE,
+        .frames = sound.size / 4
+    };
+
+    bool result = writeAsset(output, &header, sizeof(header), NULL, 0, sound.data, sound.size);
+    data_freeBuffer(&sound);
+
+    return result;
+}
+
+static bool cookAnimations(const char* name, const char* output) {
+    Data_Animations animations = { 0 };
+
+    if (!utils_loadAnimationData(name, &animations)) {
+        fprintf(stderr, "cook-assets: Unable to load animations %s.\n", name);
+        return false;
+    }
+
+    Cooked_AnimationHeader header = {
+        .magic = COOKED_ANIMATION_MAGIC,
+        .numAnimations = animations.numAnimations,
+        .numFrames = animations.numFrames
+    };
+
+    bool result = writeAsset(output, &header, sizeof(header), animations.animations, (size_t) animations.numAnimations * sizeof(Data_Animation), animations.frames, (size_t) animations.numFrames * 2);
+    data_freeAnimations(&animations);
+
+    return result;
+}
+
+int main(int argc, char const *argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "Usage: cook-assets <output-dir> <asset>...\n");
+        return 1;
+    }
+
+    for (int i = 2; i < argc; ++i) {
+        const char* name = argv[i];
+        char output[MAX_PATH_LENGTH];
+
+        if (snprintf(output, MAX_PATH_LENGTH, "%s/%s", argv[1], name) >= MAX_PATH_LENGTH) {
+            fprintf(stderr, "cook-assets: Path too long for %s.\n", name);
+            return 1;
+        }
+
+        bool result = true;
+
+        if (hasExtension(name, ".bmp")) {
+            result = cookImage(name, output);
+        } else if (hasExtension(name, ".wav")) {
+            result = cookSound(name, output);
+        } else if (hasExtension(name, ".anim")) {
+            result = cookAnimations(name, output);
+        }
+
+        if (!result) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,207 @@
+////////////////////////////////////////////////////////////////////////////////////
+// The MIT License (MIT)
+// 
+// Copyright (c) 2021 Tarek Sherif
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////
+// Pack asset files into a single archive (see archive.h).
+//
+// Usage: pack-assets <output> <asset>...
+//
+// Assets are stored under the path they're given on the command
+// line, so it should be run from the directory the game resolves
+// asset paths against (i.e. paths like "assets/sprites/ship.bmp").
+//////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../src/shared/archive.h"
+
+typedef struct {
+    const char* name;
+    uint8_t* data;
+    uint32_t size;
+    Archive_Entry entry;
+} Asset;
+
+static bool readAsset(const char* name, Asset* asset) {
+    FILE* file = fopen(name, "rb");
+
+    if (!file) {
+        fprintf(stderr, "pack-assets: Unable to open %s.\n", name);
+        goto ERROR_NO_RESOURCES;
+    }
+
+    if (fseek(file, 0, SEEK_END) != 0) {
+        goto ERROR_FILE_OPENED;
+    }
+
+    long size = ftell(file);
+    if (size < 0 || fseek(file, 0, SEEK_SET) != 0) {
+        goto ERROR_FILE_OPENED;
+    }
+
+    // Extra byte so empty files still get an allocation.
+    uint8_t* data = (uint8_t *) malloc(size + 1);
+    if (!data) {
+        goto ERROR_FILE_OPENED;
+    }
+
+    if (fread(data, 1, size, file) != (size_t) size) {
+        goto ERROR_DATA_ALLOCATED;
+    }
+
+    fclose(file);
+
+    asset->name = name;
+    asset->data = data;
+    asset->size = (uint32_t) size;
+    asset->entry.hash = archive_hash(name);
+    asset->entry.nameLength = (uint32_t) strlen(name);
+    asset->entry.size = (uint32_t) size;
+    asset->entry.alignment = ARCHIVE_ALIGNMENT;
+
+    return true;
+
+    ERROR_DATA_ALLOCATED:
+    free(data);
+
+    ERROR_FILE_OPENED:
+    fprintf(stderr, "pack-assets: Unable to read %s.\n", name);
+    fclose(file);
+
+    ERROR_NO_RESOURCES:
+    return false;
+}
+
+static int compareAssets(const void* a, const void* b) {
+    uint32_t hashA = ((const Asset *) a)->entry.hash;
+    uint32_t hashB = ((const Asset *) b)->entry.hash;
+
+    return (hashA > hashB) - (hashA < hashB);
+}
+
+int main(int argc, char const *argv[]) {
+    int exitStatus = 1;
+
+    if (argc < 2) {
+        fprintf(stderr, "Usage: pack-assets <output> <asset>...\n");
+        goto EXIT_NO_RESOURCES;
+    }
+
+    uint32_t count = argc - 2;
+    Asset* assets = (Asset *) calloc(count + 1, sizeof(Asset));
+
+    if (!assets) {
+        goto EXIT_NO_RESOURCES;
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+        if (!readAsset(argv[i + 2], assets + i)) {
+            goto EXIT_ASSETS;
+        }
+    }
+
+    ///////////////////////////////////////////////////////
+    // Sort the index by hash for binary search at runtime
+    // and lay out paths, then contents, after it.
+    ///////////////////////////////////////////////////////
+
+    qsort(assets, count, sizeof(Asset), compareAssets);
+
+    uint64_t offset = sizeof(Archive_Header) + (uint64_t) count * sizeof(Archive_Entry);
+
+    for (uint32_t i = 0; i < count; ++i) {
+        assets[i].entry.nameOffset = (uint32_t) offset;
+        offset += assets[i].entry.nameLength;
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+        if (i > 0 && assets[i].entry.hash == assets[i - 1].entry.hash) {
+            fprintf(stderr, "pack-assets: Hash collision between %s and %s.\n", assets[i - 1].name, assets[i].name);
+            goto EXIT_ASSETS;
+        }
+
+        uint32_t alignment = assets[i].entry.alignment;
+        offset = (offset + alignment - 1) / alignment * alignment;
+        assets[i].entry.offset = (uint32_t) offset;
+        offset += assets[i].size;
+    }
+
+    if (offset > UINT32_MAX) {
+        fprintf(stderr, "pack-assets: Archive too large.\n");
+        goto EXIT_ASSETS;
+    }
+
+    Archive_Header header = {
+        .magic = ARCHIVE_MAGIC,
+        .version = ARCHIVE_VERSION,
+        .count = count,
+        .size = (uint32_t) offset
+    };
+
+    FILE* output = fopen(argv[1], "wb");
+
+    if (!output) {
+        fprintf(stderr, "pack-assets: Unable to open %s.\n", argv[1]);
+        goto EXIT_ASSETS;
+    }
+
+    bool written = fwrite(&header, sizeof(header), 1, output) == 1;
+
+    for (uint32_t i = 0; written && i < count; ++i) {
+        written = fwrite(&assets[i].entry, sizeof(Archive_Entry), 1, output) == 1;
+    }
+
+    uint64_t position = sizeof(Archive_Header) + (uint64_t) count * sizeof(Archive_Entry);
+    for (uint32_t i = 0; written && i < count; ++i) {
+        written = fwrite(assets[i].name, 1, assets[i].entry.nameLength, output) == assets[i].entry.nameLength;
+        position += assets[i].entry.nameLength;
+    }
+
+    for (uint32_t i = 0; written && i < count; ++i) {
+        while (written && position < assets[i].entry.offset) {
+            written = fputc(0, output) != EOF;
+            ++position;
+        }
+
+        written = written && fwrite(assets[i].data, 1, assets[i].size, output) == assets[i].size;
+        position += assets[i].size;
+    }
+
+    if (fclose(output) != 0 || !written) {
+        fprintf(stderr, "pack-assets: Unable to write %s.\n", argv[1]);
+        remove(argv[1]);
+        goto EXIT_ASSETS;
+    }
+
+    exitStatus = 0;
+
+    EXIT_ASSETS:
+    for (uint32_t i = 0; i < count; ++i) {
+        free(assets[i].data);
+    }
+    free(assets);
+
+    EXIT_NO_RESOURCES:
+    return exitStatus;
+}